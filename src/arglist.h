@@ -25,27 +25,27 @@ public:
     virtual ~ArgList() {}
 
     Container::const_iterator begin() const { return begin_; }
-    Container::const_iterator end() const { return container_->cend(); }
+    Container::const_iterator end() const { return end_; }
     const std::string& front() { return *begin_; }
-    const std::string& back() { return container_->back(); }
-    bool empty() const { return begin_ == container_->end(); }
+    const std::string& back() { return *(end_ - 1); }
+    bool empty() const { return begin_ == end_; }
     Container::size_type size() const {
-        return std::distance(begin_, container_->cend());
+        return std::distance(begin_, end_);
     }
 
     std::string join(char delim = '.');
 
     //! reset internal pointer to begin of arguments
     void reset() {
-        begin_ = container_->cbegin();
+        begin_ = first_;
         shiftedTooFar_ = false;
     }
     //! shift the internal pointer by amount
     void shift(Container::difference_type amount = 1) {
-        begin_ += std::min(amount, std::distance(begin_, container_->cend()));
+        begin_ += std::min(amount, std::distance(begin_, end_));
     }
     Container toVector() const {
-        return Container(begin_, container_->cend());
+        return Container(begin_, end_);
     }
     //! try read a value if possible
     virtual ArgList& operator>>(std::string& val);
@@ -56,6 +56,16 @@ public:
     }
 
 protected:
+    //! a view on the range [from, to) of the given container. The
+    //! arguments are shared, not copied.
+    ArgList(std::shared_ptr<Container> container,
+            Container::const_iterator from, Container::const_iterator to);
+    //! make the view range cover the entire container_
+    void viewEntireContainer();
+
+    //! the range in container_ that this ArgList refers to
+    Container::const_iterator first_;
+    Container::const_iterator end_;
     //! shift state pointing into container_
     Container::const_iterator begin_;
     //! indicator that we attempted to shift too far (shift is at end())
@@ -63,7 +73,7 @@ protected:
     /*! Argument vector
      * @note This is a shared pointer to make object copy-able:
      * 1. payload is shared (no redundant copies)
-     * 2. begin_ stays valid
+     * 2. first_, begin_ and end_ stay valid
      * 3. The C-style compatibility layer DEPENDS on the shared_ptr!
      */
     std::shared_ptr<Container> container_;
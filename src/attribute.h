@@ -63,6 +63,9 @@ public:
 
     virtual std::string str() { return {}; }
     virtual std::string change(const std::string &payload) = 0;
+    //! check whether change() would accept the given value, but without
+    //! changing anything. Returns the error message change() would return.
+    virtual std::string checkValue(const std::string &payload) = 0;
     //! suggestions for a new value of the attribute
     virtual void complete(Completion& complete) = 0;
 
@@ -142,6 +142,35 @@ public:
     }
 
     std::string change(const std::string &payload_str) override {
+        return parseAndValidate(payload_str, [this](const T& new_payload) {
+            // set and trigger stuff
+            if (new_payload != payload_) {
+                this->operator=(new_payload);
+                changedByUser_.emit(payload_);
+            }
+        });
+    }
+
+    std::string checkValue(const std::string &payload_str) override {
+        return parseAndValidate(payload_str, [](const T&) {});
+    }
+
+    const T& operator*() const {
+        return payload_;
+    }
+    const T* operator->() const {
+        return &payload_;
+    }
+    const T& operator()() const {
+        return payload_;
+    }
+
+protected:
+    //! parse and validate the given string and pass the new value
+    //! to 'onSuccess' if it is acceptable for this attribute
+    std::string parseAndValidate(const std::string &payload_str,
+                                 std::function<void(const T&)> onSuccess)
+    {
         if (!writeable()) {
             return "attribute is read-only";
         }
@@ -155,12 +184,7 @@ public:
                     return error_message;
                 }
             }
-
-            // set and trigger stuff
-            if (new_payload != payload_) {
-                this->operator=(new_payload);
-                changedByUser_.emit(payload_);
-            }
+            onSuccess(new_payload);
         } catch (std::invalid_argument const& e) {
             return std::string("invalid argument: ") + e.what();
         } catch (std::out_of_range const& e) {
@@ -169,17 +193,6 @@ public:
         return {}; // all good
     }
 
-    const T& operator*() const {
-        return payload_;
-    }
-    const T* operator->() const {
-        return &payload_;
-    }
-    const T& operator()() const {
-        return payload_;
-    }
-
-protected:
     void notifyHooks() {
         if (owner_) {
             owner_->notifyHooks(HookEvent::ATTRIBUTE_CHANGED, name_);
@@ -308,6 +321,22 @@ public:
         }
     }
 
+    //! Validation happens in the setter, so we can only check
+    //! whether the value can be parsed
+    std::string checkValue(const std::string &payload_str) override {
+        if (!writeable()) {
+            return "attribute is read-only";
+        }
+        try {
+            Converter<T>::parse(payload_str); // throws
+        } catch (std::invalid_argument const& e) {
+            return std::string("invalid argument: ") + e.what();
+        } catch (std::out_of_range const& e) {
+            return std::string("out of range: ") + e.what();
+        }
+        return {};
+    }
+
 private:
     std::function<T()> getter_;
     std::function<std::string(T)> setter_;
@@ -9,6 +9,8 @@
 #include "clientmanager.h"
 #include "decoration.h"
 #include "ewmh.h"
+#include "frametree.h"
+#include "layout.h"
 #include "globals.h"
 #include "hook.h"
 #include "ipc-protocol.h"
@@ -52,6 +54,7 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     , sizehints_tiling_(this, "sizehints_tiling", false)
     , window_class_(this, "class", &Client::getWindowClass)
     , window_instance_(this, "instance", &Client::getWindowInstance)
+    , decorationSkippedUpdates_(this, "decoration_skipped_updates", &Client::decorationSkippedUpdates)
     , manager(cm)
     , theme(*cm.theme)
     , settings(*cm.settings)
@@ -66,6 +69,16 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
     ewmhrequests_.setWriteable();
     sizehints_floating_.setWriteable();
     sizehints_tiling_.setWriteable();
+    // in the max layout, the pseudotile state affects which clients are
+    // visible, so the frame's layout has to be recomputed
+    pseudotile_.changed().connect([this] {
+        if (tag_) {
+            auto frame = tag_->frame->findFrameWithClient(this);
+            if (frame) {
+                frame->invalidateLayout();
+            }
+        }
+    });
     for (auto i : {&fullscreen_, &pseudotile_, &sizehints_floating_, &sizehints_tiling_}) {
         i->setWriteable();
         i->changed().connect(this, &Client::requestRedraw);
@@ -82,6 +95,7 @@ Client::Client(Window window, bool visible_already, ClientManager& cm)
             }
             });
     fullscreen_.changed().connect(this, &Client::updateEwmhState);
+    urgent_.changed().connect(this, &Client::updateUrgentIndex);
 
     init_from_X();
 }
@@ -129,10 +143,28 @@ void Client::listen_for_events() {
 }
 
 void Client::setTag(HSTag *tag) {
+    if (tag_) {
+        tag_->setClientUrgent(this, false);
+    }
     tag_ = tag;
+    if (tag_) {
+        tag_->setClientUrgent(this, urgent_());
+    }
     ewmh.windowUpdateTag(window_, tag);
 }
 
+//! keep the urgent clients of the client manager and of the tag up to date
+void Client::updateUrgentIndex() {
+    if (urgent_()) {
+        manager.urgentClients_.insert(this);
+    } else {
+        manager.urgentClients_.erase(this);
+    }
+    if (tag_) {
+        tag_->setClientUrgent(this, urgent_());
+    }
+}
+
 bool Client::ignore_unmapnotify() {
     if (ignore_unmaps_ > 0) {
         ignore_unmaps_--;
@@ -155,6 +187,10 @@ Client::~Client() {
     if (lastfocus == this) {
         lastfocus = nullptr;
     }
+    manager.urgentClients_.erase(this);
+    if (tag_) {
+        tag_->setClientUrgent(this, false);
+    }
     if (slice) {
         delete slice;
     }
@@ -568,12 +604,61 @@ void Client::updateEwmhState() {
 
 string Client::getWindowClass()
 {
-    return ewmh.X().getClass(window_);
+    return wmClass();
 }
 
 string Client::getWindowInstance()
 {
-    return ewmh.X().getInstance(window_);
+    return wmInstance();
+}
+
+const std::pair<string, string>& Client::classHint() const
+{
+    if (!propertyCache_.hasClassHint) {
+        propertyCache_.classHint = ewmh.X().getClassHint(window_);
+        propertyCache_.hasClassHint = true;
+    }
+    return propertyCache_.classHint;
+}
+
+const string& Client::wmClass() const
+{
+    return classHint().second;
+}
+
+const string& Client::wmInstance() const
+{
+    return classHint().first;
+}
+
+//! the name of the window type atom, if the window type is set
+const std::experimental::optional<string>& Client::windowType() const
+{
+    if (!propertyCache_.hasWindowType) {
+        int wintype = ewmh.getWindowType(window_);
+        if (wintype < 0) {
+            propertyCache_.windowType = {};
+        } else {
+            propertyCache_.windowType = string(ewmh.netatomName(wintype));
+        }
+        propertyCache_.hasWindowType = true;
+    }
+    return propertyCache_.windowType;
+}
+
+const std::experimental::optional<string>& Client::windowRole() const
+{
+    if (!propertyCache_.hasWindowRole) {
+        propertyCache_.windowRole =
+            ewmh.X().getWindowProperty(window_, ewmh.wmatom(Ewmh::WM::WindowRole));
+        propertyCache_.hasWindowRole = true;
+    }
+    return propertyCache_.windowRole;
+}
+
+void Client::invalidatePropertyCache()
+{
+    propertyCache_ = {};
 }
 
 void Client::requestRedraw()
@@ -655,6 +740,10 @@ string Client::tagName() {
     return tag_ ? tag_->name() : "";
 }
 
+unsigned long Client::decorationSkippedUpdates() const {
+    return dec->skippedUpdates();
+}
+
 Window Client::decorationWindow() {
     return dec->decorationWindow();
 }
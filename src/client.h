@@ -3,9 +3,11 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <memory>
 
 #include "attribute_.h"
 #include "object.h"
+#include "optional.h"
 #include "regexstr.h"
 #include "types.h"
 #include "x11-types.h"
@@ -13,6 +15,7 @@
 class Decoration;
 class DecTriple;
 class Ewmh;
+class FrameLeaf;
 class Slice;
 class HSTag;
 class Monitor;
@@ -31,6 +34,8 @@ public:
     Rectangle   float_size_ = {0, 0, 100, 100};     // floating size without the window border
     HSTag*      tag_ = {};
     Slice* slice = {};
+    //! the frame that contains this client, maintained by the FrameLeaf
+    std::weak_ptr<FrameLeaf> frameLeaf_;
     bool        ewmhfullscreen_ = false; // ewmh fullscreen state
     bool        neverfocus_ = false; // do not give the focus via XSetInputFocus
     bool        visible_;
@@ -71,6 +76,7 @@ public:
     Attribute_<bool> sizehints_tiling_;  // respect size hints regarding this client in tiling mode
     DynAttribute_<std::string> window_class_;
     DynAttribute_<std::string> window_instance_;
+    DynAttribute_<unsigned long> decorationSkippedUpdates_;
 
 public:
     void init_from_X();
@@ -119,10 +125,36 @@ public:
     void clear_properties();
     bool ignore_unmapnotify();
 
+    // X properties of the window that are cached (e.g. for the rules)
+    const std::string& wmClass() const;
+    const std::string& wmInstance() const;
+    const std::experimental::optional<std::string>& windowType() const;
+    const std::experimental::optional<std::string>& windowRole() const;
+    //! drop the cached X properties, e.g. when the window changes them
+    void invalidatePropertyCache();
+
     void updateEwmhState();
 private:
+    void updateUrgentIndex();
+    /** Properties of the window that need an X round trip each, but
+     * are read often, e.g. by every rule condition when the client appears.
+     * Each entry is fetched on its first access and stays valid until the
+     * next PropertyNotify event of the window.
+     */
+    struct PropertyCache {
+        bool hasClassHint = false;
+        std::pair<std::string, std::string> classHint; // instance and class
+        bool hasWindowType = false;
+        std::experimental::optional<std::string> windowType;
+        bool hasWindowRole = false;
+        std::experimental::optional<std::string> windowRole;
+    };
+    mutable PropertyCache propertyCache_;
+    const std::pair<std::string, std::string>& classHint() const;
+
     std::string getWindowClass();
     std::string getWindowInstance();
+    unsigned long decorationSkippedUpdates() const;
     std::string triggerRelayoutMonitor();
     void requestRedraw();
     friend Decoration;
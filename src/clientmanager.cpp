@@ -2,6 +2,7 @@
 
 #include <X11/Xlib.h>
 #include <algorithm>
+#include <iostream>
 #include <string>
 
 #include "attribute.h"
@@ -80,9 +81,9 @@ Client* ClientManager::client(const string &identifier)
         return focus();
     }
     if (identifier == "urgent") {
-        for (auto c : clients_) {
-            if (c.second->urgent_) {
-                return c.second;
+        for (auto c : urgentClients_) {
+            if (c->tag()) {
+                return c;
             }
         }
         return {}; // no urgent client found
@@ -99,8 +100,15 @@ Client* ClientManager::client(const string &identifier)
 void ClientManager::completeClients(Completion& complete)
 {
     complete.full("urgent");
-    for (const auto& it : clients_) {
-        complete.full(Converter<WindowID>::str(it.first));
+    // the children are sorted by the window id string, so we only need to
+    // look at the clients matching the needle
+    auto range = complete.candidates(children());
+    for (auto it = range.first; it != range.second; it++) {
+        Client* client = static_cast<Client*>(it->second);
+        // skip links like 'focus' or 'dragged'
+        if (it->first == client->window_id_str()) {
+            complete.full(it->first);
+        }
     }
 }
 
@@ -335,6 +343,26 @@ int ClientManager::applyRules(Client* client, Output output, bool changeFocus)
     ClientChanges changes;
     changes.focus = client == focus();
     changes = Root::get()->rules()->evaluateRules(client, changes);
+    return applyChanges(client, changes, output, changeFocus);
+}
+
+//! re-apply the rules with the 'reapply' flag that depend on the
+//! given property of the client, after it changed
+void ClientManager::propertyChanged(Client* client, const string& property)
+{
+    RuleManager* rules = Root::get()->rules();
+    if (!rules->hasReapplyRules(property)) {
+        return;
+    }
+    ClientChanges changes;
+    changes.focus = client == focus();
+    changes = rules->reevaluateRules(property, client, changes);
+    applyChanges(client, changes, std::cerr, true);
+}
+
+//! apply the outcome of the rules to the given client
+int ClientManager::applyChanges(Client* client, ClientChanges changes, Output output, bool changeFocus)
+{
     if (changes.manage == false) {
         // only make unmanaging clients possible as soon as it is
         // possible to make them managed again
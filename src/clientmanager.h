@@ -3,6 +3,7 @@
 
 #include <X11/X.h>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "link.h"
 #include "object.h"
@@ -58,14 +59,18 @@ public:
     int applyRulesCmd(Input input, Output output);
     int applyRules(Client* client, Output output, bool changeFocus = true);
     void applyRulesCompletion(Completion& complete);
+    void propertyChanged(Client* client, const std::string& property);
 
 protected:
     int clientSetAttribute(std::string attribute, Input input, Output output);
     void setSimpleClientAttributes(Client* client, const ClientChanges& changes);
+    int applyChanges(Client* client, ClientChanges changes, Output output, bool changeFocus);
     Theme* theme;
     Settings* settings;
     Ewmh* ewmh;
     std::unordered_map<Window, Client*> clients_;
+    //! the urgent clients, maintained by the clients themselves
+    std::unordered_set<Client*> urgentClients_;
     friend class Client;
 };
 
@@ -466,10 +466,15 @@ int complete_against_commands(int argc, char** argv, int position,
                               Output output) {
     // complete command
     if (position == 0) {
-        char* str = (argc >= 1) ? argv[0] : nullptr;
-        for (auto cmd : *Commands::get()) {
-            // only check the first len bytes
-            try_complete(str, cmd.first.c_str(), output);
+        string needle = (argc >= 1) ? argv[0] : "";
+        auto commandTable = Commands::get();
+        // only visit the commands starting with the needle
+        for (auto it = commandTable->lower_bound(needle);
+             it != commandTable->end()
+             && Completion::prefixOf(needle, it->first);
+             it++)
+        {
+            try_complete(needle.c_str(), it->first.c_str(), output);
         }
         return 0;
     }
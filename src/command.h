@@ -2,8 +2,8 @@
 #define __HERBSTLUFT_COMMAND_H_
 
 #include <functional>
+#include <map>
 #include <string>
-#include <unordered_map>
 
 #include "types.h"
 
@@ -117,7 +117,9 @@ private:
 };
 
 class CommandTable {
-    using Container = std::unordered_map<std::string, CommandBinding>;
+    // sorted by the command name, such that all commands with a common
+    // prefix are adjacent (for the command completion)
+    using Container = std::map<std::string, CommandBinding>;
 
 public:
     CommandTable(std::initializer_list<Container::value_type> values)
@@ -128,6 +130,9 @@ public:
     Container::const_iterator begin() const { return map.cbegin(); }
     Container::const_iterator end() const { return map.cend(); }
     Container::const_iterator find(const std::string& str) const { return map.find(str); }
+    Container::const_iterator lower_bound(const std::string& str) const {
+        return map.lower_bound(str);
+    }
 private:
     Container map;
 };
@@ -20,7 +20,7 @@ Completion::Completion(ArgList args, size_t index, bool shellOutput, Output outp
     , shellOutput_(shellOutput)
 {
     if (index_ < args_.size()) {
-        needle_ = args_.toVector()[index_];
+        needle_ = *(args_.begin() + index_);
     } else {
         needle_ = "";
     }
@@ -65,6 +65,9 @@ bool Completion::noParameterExpected() const {
 
 bool Completion::prefixOf(const string& shorter, const string& longer)
 {
+    if (shorter.size() > longer.size()) {
+        return false;
+    }
     auto res = std::mismatch(shorter.begin(), shorter.end(), longer.begin());
     return res.first == shorter.end();
 }
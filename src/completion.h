@@ -1,6 +1,10 @@
 #ifndef HLWM_COMPLETION
 #define HLWM_COMPLETION
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include "arglist.h"
 #include "types.h"
 
@@ -61,6 +65,36 @@ public:
 
     static bool prefixOf(const std::string& shorter, const std::string& longer);
     const std::string& needle() const;
+
+    //! a range of entries in a map with string keys
+    template<typename T>
+    using MapRange = std::pair<typename std::map<std::string, T>::const_iterator,
+                               typename std::map<std::string, T>::const_iterator>;
+    /** Return the range of entries of the sorted map whose keys can
+     * complete the needle when 'prefix' is put in front of them. This avoids
+     * checking every key of the map, because the keys starting with the
+     * same string are adjacent in the map.
+     */
+    template<typename T>
+    MapRange<T> candidates(const std::map<std::string, T>& sortedMap,
+                           const std::string& prefix = {}) const
+    {
+        if (!prefixOf(prefix, needle_)) {
+            if (prefixOf(needle_, prefix)) {
+                // the prefix is already longer than the needle
+                return { sortedMap.begin(), sortedMap.end() };
+            } else {
+                return { sortedMap.end(), sortedMap.end() };
+            }
+        }
+        std::string keyPrefix = needle_.substr(prefix.size());
+        auto begin = sortedMap.lower_bound(keyPrefix);
+        auto end = begin;
+        while (end != sortedMap.end() && prefixOf(keyPrefix, end->first)) {
+            end++;
+        }
+        return { begin, end };
+    }
     size_t needleIndex() const { return index_; };
 
     /** Grants access to private members as long as Commands::complete is still
@@ -2,6 +2,7 @@
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <algorithm>
 
 #include "client.h"
 #include "ewmh.h"
@@ -13,6 +14,8 @@ using std::string;
 using std::vector;
 
 std::map<Window,Client*> Decoration::decwin2client;
+std::map<Decoration::ColorKey,unsigned long> Decoration::colorCache;
+std::vector<Decoration::PooledWindows> Decoration::s_windowPool;
 
 // from openbox/frame.c
 static Visual* check_32bit_client(Client* c)
@@ -38,10 +41,38 @@ Decoration::Decoration(Client* client, Settings& settings)
 
 void Decoration::createWindow() {
     Decoration* dec = this;
-    XSetWindowAttributes at;
-    long mask = 0;
     // copy attributes from client and not from the root window
     Visual* visual = check_32bit_client(client_);
+    dec->visualId = visual ? XVisualIDFromVisual(visual) : 0;
+    auto pooled = std::find_if(s_windowPool.begin(), s_windowPool.end(),
+        [this](const PooledWindows& p) { return p.visualId == visualId; });
+    if (pooled != s_windowPool.end()) {
+        // reuse the windows of a previous decoration with the same visual
+        dec->decwin = pooled->decwin;
+        dec->borderwin = pooled->borderwin;
+        dec->innerwin = pooled->innerwin;
+        dec->bgwin = pooled->bgwin;
+        dec->colormap = pooled->colormap;
+        dec->depth = pooled->depth;
+        s_windowPool.erase(pooled);
+    } else {
+        createWindows(visual);
+    }
+    // use a clients requested initial floating size as the initial size
+    dec->last_rect_inner = true;
+    dec->last_inner_rect = client_->float_size_;
+    dec->last_outer_rect = client_->float_size_; // TODO: is this correct?
+    dec->last_actual_rect = dec->last_inner_rect;
+    dec->last_actual_rect.x -= dec->last_outer_rect.x;
+    dec->last_actual_rect.y -= dec->last_outer_rect.y;
+    decwin2client[decwin] = client_;
+}
+
+//! create the decoration windows for a client with the given visual
+void Decoration::createWindows(Visual* visual) {
+    Decoration* dec = this;
+    XSetWindowAttributes at;
+    long mask = 0;
     if (visual) {
         /* client has a 32-bit visual */
         mask = CWColormap | CWBackPixel | CWBorderPixel;
@@ -74,21 +105,23 @@ void Decoration::createWindow() {
         at.background_pixel = BlackPixel(g_display, g_screen);
         at.border_pixel = BlackPixel(g_display, g_screen);
     }
+    auto createSubwindow = [&](Window parent) {
+        return XCreateWindow(g_display, parent, 0,0, 30, 30, 0,
+                             dec->depth,
+                             InputOutput,
+                             CopyFromParent,
+                             mask, &at);
+    };
+    // the sub-windows are stacked in the order of their creation: the
+    // client window will be above all of them. The innerwin is a child of
+    // the borderwin such that the outer border is painted over the inner
+    // border if they overlap.
+    dec->borderwin = createSubwindow(dec->decwin);
+    dec->innerwin = createSubwindow(dec->borderwin);
+    XMapWindow(g_display, dec->innerwin);
     dec->bgwin = 0;
-    dec->bgwin = XCreateWindow(g_display, dec->decwin, 0,0, 30, 30, 0,
-                        dec->depth,
-                        InputOutput,
-                        CopyFromParent,
-                        mask, &at);
+    dec->bgwin = createSubwindow(dec->decwin);
     XMapWindow(g_display, dec->bgwin);
-    // use a clients requested initial floating size as the initial size
-    dec->last_rect_inner = true;
-    dec->last_inner_rect = client_->float_size_;
-    dec->last_outer_rect = client_->float_size_; // TODO: is this correct?
-    dec->last_actual_rect = dec->last_inner_rect;
-    dec->last_actual_rect.x -= dec->last_outer_rect.x;
-    dec->last_actual_rect.y -= dec->last_outer_rect.y;
-    decwin2client[decwin] = client_;
     // set wm_class for window
     XClassHint *hint = XAllocClassHint();
     hint->res_name = (char*)HERBST_DECORATION_CLASS;
@@ -98,19 +131,45 @@ void Decoration::createWindow() {
 }
 
 Decoration::~Decoration() {
+    if (!decwin) {
+        return;
+    }
     decwin2client.erase(decwin);
+    if (s_windowPool.size() < s_windowPoolSize) {
+        // keep the windows for the next client with the same visual. The
+        // client window has already been reparented to the root window.
+        // Everything else is set again by the first resize_outline().
+        XUnmapWindow(g_display, decwin);
+        if (borderwinMapped_) {
+            XUnmapWindow(g_display, borderwin);
+        }
+        PooledWindows pooled;
+        pooled.visualId = visualId;
+        pooled.decwin = decwin;
+        pooled.borderwin = borderwin;
+        pooled.innerwin = innerwin;
+        pooled.bgwin = bgwin;
+        pooled.colormap = colormap;
+        pooled.depth = depth;
+        s_windowPool.push_back(pooled);
+        return;
+    }
     if (colormap) {
+        // forget the pixel values allocated in the private colormap
+        colorCache.erase(colorCache.lower_bound(ColorKey(colormap, 0, 0, 0)),
+                         colorCache.upper_bound(ColorKey(colormap, 0xffff, 0xffff, 0xffff)));
         XFreeColormap(g_display, colormap);
     }
-    if (pixmap) {
-        XFreePixmap(g_display, pixmap);
-    }
     if (bgwin) {
         XDestroyWindow(g_display, bgwin);
     }
-    if (decwin) {
-        XDestroyWindow(g_display, decwin);
+    if (innerwin) {
+        XDestroyWindow(g_display, innerwin);
+    }
+    if (borderwin) {
+        XDestroyWindow(g_display, borderwin);
     }
+    XDestroyWindow(g_display, decwin);
 }
 
 Client* Decoration::toClient(Window decoration_window)
@@ -194,11 +253,6 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     inner.x = tile.x + ((dx < threshold) ? 0 : dx);
     inner.y = tile.y + ((dy < threshold) ? 0 : dy);
 
-    //if (RECTANGLE_EQUALS(client->last_size, rect)
-    //    && client->last_border_width == border_width) {
-    //    return;
-    //}
-
     if (scheme.tight_decoration()) {
         // updating the outline only has an affect for tiled clients
         // because for floating clients, this has been done already
@@ -228,27 +282,41 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     //}
     // send new size to client
     // update structs
-    bool size_changed = outline.width != last_outer_rect.width
-                     || outline.height != last_outer_rect.height;
     last_outer_rect = outline;
     last_rect_inner = false;
     client_->last_size_ = inner;
     last_scheme = &scheme;
-    // redraw
-    // TODO: reduce flickering
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
+    bool applyClientGeometry =
+        !client_->dragged_ || settings_.update_dragged_clients();
+    // skip all X requests if the same geometry and scheme
+    // has already been applied
+    AppliedState state;
+    state.valid = true;
+    state.scheme = &scheme;
+    state.schemeRevision = scheme.revision();
+    state.outline = outline;
+    state.inner = inner;
+    state.clientGeometryApplied = applyClientGeometry;
+    if (state == applied_) {
+        skippedUpdates_++;
+        if (applyClientGeometry) {
+            // the client may wait for the reply to its ConfigureRequest
+            // even if nothing changes (ICCCM 4.1.5)
+            client_->send_configure();
+        }
+        return;
+    }
+    bool colorsChanged = state.scheme != applied_.scheme
+                      || state.schemeRevision != applied_.schemeRevision;
+    applied_ = state;
+    if (applyClientGeometry) {
         last_actual_rect.x = changes.x;
         last_actual_rect.y = changes.y;
         last_actual_rect.width = changes.width;
         last_actual_rect.height = changes.height;
     }
-    redrawPixmap();
-    XSetWindowBackgroundPixmap(g_display, decwin, pixmap);
-    if (!size_changed) {
-        // if size changes, then the window is cleared automatically
-        XClearWindow(g_display, decwin);
-    }
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
+    redraw(colorsChanged);
+    if (applyClientGeometry) {
         XConfigureWindow(g_display, win, mask, &changes);
         XMoveResizeWindow(g_display, bgwin,
                           changes.x, changes.y,
@@ -257,10 +325,21 @@ void Decoration::resize_outline(Rectangle outline, const DecorationScheme& schem
     XMoveResizeWindow(g_display, decwin,
                       outline.x, outline.y, outline.width, outline.height);
     updateFrameExtends();
-    if (!client_->dragged_ || settings_.update_dragged_clients()) {
+    if (applyClientGeometry) {
         client_->send_configure();
     }
-    XSync(g_display, False);
+    // the requests are only queued here. They are flushed once for the
+    // entire layout pass, see Monitor::applyLayout()
+}
+
+bool Decoration::AppliedState::operator==(const AppliedState& other) const
+{
+    return valid == other.valid
+        && scheme == other.scheme
+        && schemeRevision == other.schemeRevision
+        && outline == other.outline
+        && inner == other.inner
+        && clientGeometryApplied == other.clientGeometryApplied;
 }
 
 void Decoration::updateFrameExtends() {
@@ -285,91 +364,79 @@ void Decoration::change_scheme(const DecorationScheme& scheme) {
 
 unsigned int Decoration::get_client_color(Color color) {
     XColor xcol = color.toXColor();
-    if (colormap) {
-        /* get pixel value back appropriate for client */
-        XAllocColor(g_display, colormap, &xcol);
-        return xcol.pixel;
-    } else {
-        /* get pixel value back appropriate for main color map*/
-        XAllocColor(g_display, DefaultColormap(g_display, g_screen), &xcol);
-        return xcol.pixel;
+    /* get pixel value back appropriate for client or for main color map */
+    Colormap cmap = colormap ? colormap : DefaultColormap(g_display, g_screen);
+    ColorKey key(cmap, xcol.red, xcol.green, xcol.blue);
+    auto it = colorCache.find(key);
+    if (it != colorCache.end()) {
+        return it->second;
     }
+    XAllocColor(g_display, cmap, &xcol);
+    colorCache[key] = xcol.pixel;
+    return xcol.pixel;
 }
 
-// draw a decoration to the client->dec.pixmap
-void Decoration::redrawPixmap() {
+/** Paint the decoration. Instead of drawing into a pixmap of the size of
+ * the entire decoration, the decoration is composed of windows whose
+ * background (and border) colors are painted by the X server:
+ *
+ *  - decwin has the outer color
+ *  - borderwin covers everything except the outer border and has the
+ *    border color
+ *  - innerwin is the inner rectangle with the background color; its X
+ *    window border is the inner border. It is a child of borderwin and
+ *    thus clipped to it, so the outer border is drawn on top of it.
+ *  - bgwin and the client window are on top of borderwin.
+ *
+ * So no server side memory is needed apart from the windows themselves.
+ */
+void Decoration::redraw(bool colorsChanged) {
     if (!last_scheme) {
         // do nothing if we don't have a scheme.
         return;
     }
     const DecorationScheme& s = *last_scheme;
-    auto dec = this;
     auto outer = last_outer_rect;
-    // TODO: maybe do something like pixmap recreate threshhold?
-    bool recreate_pixmap = (dec->pixmap == 0) || (dec->pixmap_width != outer.width)
-                                              || (dec->pixmap_height != outer.height);
-    if (recreate_pixmap) {
-        if (dec->pixmap) {
-            XFreePixmap(g_display, dec->pixmap);
+
+    // outer border
+    int ow = std::min((int)s.outer_width(), (outer.height + 1) / 2);
+    Rectangle border = outer.adjusted(-ow, -ow);
+    bool showBorderwin = border.width > 0 && border.height > 0;
+    if (showBorderwin) {
+        XMoveResizeWindow(g_display, borderwin, ow, ow, border.width, border.height);
+    }
+    if (showBorderwin != borderwinMapped_) {
+        if (showBorderwin) {
+            XMapWindow(g_display, borderwin);
+        } else {
+            XUnmapWindow(g_display, borderwin);
         }
-        dec->pixmap = XCreatePixmap(g_display, decwin, outer.width, outer.height, depth);
+        borderwinMapped_ = showBorderwin;
+        colorsChanged = true;
     }
-    Pixmap pix = dec->pixmap;
-    GC gc = XCreateGC(g_display, pix, 0, nullptr);
-
-    // draw background
-    XSetForeground(g_display, gc, get_client_color(s.border_color()));
-    XFillRectangle(g_display, pix, gc, 0, 0, outer.width, outer.height);
 
-    // Draw inner border
-    unsigned short iw = s.inner_width();
+    // inner border around the inner rectangle, relative to borderwin
+    int iw = static_cast<int>(s.inner_width());
     auto inner = last_inner_rect;
-    inner.x -= last_outer_rect.x;
-    inner.y -= last_outer_rect.y;
-    if (iw > 0) {
-        /* fill rectangles because drawing does not work */
-        vector<XRectangle> rects{
-            { (short)(inner.x - iw), (short)(inner.y - iw), (unsigned short)(inner.width + 2*iw), iw }, /* top */
-            { (short)(inner.x - iw), (short)(inner.y), iw, (unsigned short)(inner.height) },  /* left */
-            { (short)(inner.x + inner.width), (short)(inner.y), iw, (unsigned short)(inner.height) }, /* right */
-            { (short)(inner.x - iw), (short)(inner.y + inner.height), (unsigned short)(inner.width + 2*iw), iw }, /* bottom */
-        };
-        XSetForeground(g_display, gc, get_client_color(s.inner_color()));
-        XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
-    }
+    XWindowChanges changes;
+    changes.x = inner.x - last_outer_rect.x - ow - iw;
+    changes.y = inner.y - last_outer_rect.y - ow - iw;
+    changes.width = std::max(1, inner.width);
+    changes.height = std::max(1, inner.height);
+    changes.border_width = iw;
+    XConfigureWindow(g_display, innerwin,
+                     CWX | CWY | CWWidth | CWHeight | CWBorderWidth, &changes);
 
-    // Draw outer border
-    unsigned short ow = s.outer_width;
-    outer.x -= last_outer_rect.x;
-    outer.y -= last_outer_rect.y;
-    if (ow > 0) {
-        ow = std::min((int)ow, (outer.height+1) / 2);
-        vector<XRectangle> rects{
-            { 0, 0, (unsigned short)(outer.width), ow }, /* top */
-            { 0, (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* left */
-            { (short)(outer.width - ow), (short)ow, ow, (unsigned short)(outer.height - 2*ow) }, /* right */
-            { 0, (short)(outer.height - ow), (unsigned short)(outer.width), ow }, /* bottom */
-        };
-        XSetForeground(g_display, gc, get_client_color(s.outer_color));
-        XFillRectangles(g_display, pix, gc, &rects.front(), rects.size());
-    }
-    // fill inner rect that is not covered by the client
-    XSetForeground(g_display, gc, get_client_color(s.background_color));
-    if (dec->last_actual_rect.width < inner.width) {
-        XFillRectangle(g_display, pix, gc,
-                       dec->last_actual_rect.x + dec->last_actual_rect.width,
-                       dec->last_actual_rect.y,
-                       inner.width - dec->last_actual_rect.width,
-                       dec->last_actual_rect.height);
-    }
-    if (dec->last_actual_rect.height < inner.height) {
-        XFillRectangle(g_display, pix, gc,
-                       dec->last_actual_rect.x,
-                       dec->last_actual_rect.y + dec->last_actual_rect.height,
-                       inner.width,
-                       inner.height - dec->last_actual_rect.height);
+    if (colorsChanged) {
+        XSetWindowBackground(g_display, decwin, get_client_color(s.outer_color));
+        XClearWindow(g_display, decwin);
+        if (showBorderwin) {
+            XSetWindowBackground(g_display, borderwin, get_client_color(s.border_color));
+            XClearWindow(g_display, borderwin);
+        }
+        // changing the border color repaints the border immediately
+        XSetWindowBorder(g_display, innerwin, get_client_color(s.inner_color));
+        XSetWindowBackground(g_display, innerwin, get_client_color(s.background_color));
+        XClearWindow(g_display, innerwin);
     }
-    // clean up
-    XFreeGC(g_display, gc);
 }
-
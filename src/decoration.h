@@ -2,7 +2,10 @@
 #define __DECORATION_H_
 
 #include <X11/X.h>
+#include <X11/Xlib.h>
 #include <map>
+#include <tuple>
+#include <vector>
 
 #include "x11-types.h"
 
@@ -31,8 +34,12 @@ public:
 
     bool positionTriggersResize(Point2D p);
 
+    //! number of calls to resize_outline() that did not need any X request
+    unsigned long skippedUpdates() const { return skippedUpdates_; }
+
 private:
-    void redrawPixmap();
+    void createWindows(Visual* visual);
+    void redraw(bool colorsChanged);
     void updateFrameExtends();
     unsigned int get_client_color(Color color);
 
@@ -43,19 +50,50 @@ private:
     Rectangle   last_outer_rect = {0, 0, 0, 0}; // only valid if width >= 0
     Rectangle   last_actual_rect = {0, 0, 0, 0}; // last actual client rect, relative to decoration
     /* X specific things */
+    VisualID                visualId = 0; // 0 for the default visual
     Colormap                colormap = 0;
     unsigned int            depth = 0;
-    Pixmap                  pixmap = 0;
-    int                     pixmap_height = 0;
-    int                     pixmap_width = 0;
+    // the sub-windows that paint the decoration, see redraw()
+    Window                  borderwin = 0;
+    bool                    borderwinMapped_ = false;
+    Window                  innerwin = 0;
     // fill the area behind client with another window that does nothing,
     // especially not repainting or background filling to avoid flicker on
     // unmap
     Window                  bgwin = 0;
+    // everything that determines the X requests issued by resize_outline()
+    struct AppliedState {
+        bool valid = false;
+        // the scheme also encodes the focus and urgency state
+        const DecorationScheme* scheme = nullptr;
+        unsigned long schemeRevision = 0;
+        Rectangle outline = {0, 0, 0, 0};
+        Rectangle inner = {0, 0, 0, 0}; // relative to the outline
+        bool clientGeometryApplied = false;
+        bool operator==(const AppliedState& other) const;
+    };
+    AppliedState            applied_;
+    unsigned long           skippedUpdates_ = 0;
 private:
     Client* client_; // the client to decorate
     Settings& settings_;
     static std::map<Window,Client*> decwin2client;
+    // the pixel values allocated by get_client_color(), indexed by the
+    // colormap and the red, green, and blue components of the color
+    typedef std::tuple<Colormap,unsigned short,unsigned short,unsigned short> ColorKey;
+    static std::map<ColorKey,unsigned long> colorCache;
+    // the windows of destroyed decorations, for reuse
+    struct PooledWindows {
+        VisualID visualId;
+        Window decwin;
+        Window borderwin;
+        Window innerwin;
+        Window bgwin;
+        Colormap colormap;
+        unsigned int depth;
+    };
+    static std::vector<PooledWindows> s_windowPool;
+    static const size_t s_windowPoolSize = 16;
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "globals.h"
+#include "stack.h"
 
 using std::make_shared;
 using std::shared_ptr;
@@ -32,6 +33,7 @@ void DesktopWindow::registerDesktop(Window win) {
 void DesktopWindow::lowerDesktopWindows() {
     for (auto dw : windows) {
         XLowerWindow(g_display, dw->win_);
+        WindowStacking::get().forget(dw->win_);
     }
 }
 
@@ -83,6 +83,7 @@ Ewmh::Ewmh(XConnection& xconnection)
         { WM::Delete,       "WM_DELETE_WINDOW" },
         { WM::State,        "WM_STATE" },
         { WM::TakeFocus,    "WM_TAKE_FOCUS" },
+        { WM::WindowRole,   "WM_WINDOW_ROLE" },
     };
     for (const auto& init : wm2name) {
         auto atom = XInternAtom(X_.display(), init.second, False);
@@ -174,13 +175,11 @@ Ewmh::~Ewmh() {
 }
 
 void Ewmh::updateWmName() {
-    string name = root_->settings->wmname();
-    X_.setPropertyString(windowManagerWindow_, netatom_[NetWmName], name);
-    X_.setPropertyString(X_.root(), netatom_[NetWmName], name);
+    markDirty(NetWmName);
 }
 
 void Ewmh::updateClientList() {
-    X_.setPropertyWindow(X_.root(), netatom_[NetClientList], netClientList_);
+    markDirty(NetClientList);
 }
 
 const Ewmh::InitialState &Ewmh::initialState()
@@ -189,59 +188,158 @@ const Ewmh::InitialState &Ewmh::initialState()
 }
 
 void Ewmh::updateClientListStacking() {
-    // First: get the windows currently visible
-    vector<Window> buf;
-    auto addToVector = [&buf](Window w) { buf.push_back(w); };
-    g_monitors->extractWindowStack(true, addToVector);
-
-    // Then add all the invisible windows at the end
-    for (auto tag : *tags_) {
-        if (find_monitor_with_tag(tag)) {
-        // do not add tags because they are already added
-            continue;
-        }
-        tag->stack->extractWindows(true, addToVector);
-    }
-
-    // reverse stacking order, because ewmh requires bottom to top order
-    std::reverse(buf.begin(), buf.end());
-
-    X_.setPropertyWindow(X_.root(), netatom_[NetClientListStacking], buf);
+    markDirty(NetClientListStacking);
 }
 
 void Ewmh::addClient(Window win) {
-    netClientList_.push_back(win);
+    if (netClientListPos_.count(win) == 0) {
+        netClientListPos_[win] =
+            netClientList_.insert(netClientList_.end(), win);
+    }
     updateClientList();
     updateClientListStacking();
 }
 
 void Ewmh::removeClient(Window win) {
-    netClientList_.erase(std::remove(netClientList_.begin(), netClientList_.end(), win), netClientList_.end());
+    auto it = netClientListPos_.find(win);
+    if (it != netClientListPos_.end()) {
+        netClientList_.erase(it->second);
+        netClientListPos_.erase(it);
+    }
     updateClientList();
     updateClientListStacking();
 }
 
 void Ewmh::updateDesktops() {
-    X_.setPropertyCardinal(X_.root(), netatom_[NetNumberOfDesktops],
-                           { (long) root_->tags->size() });
+    markDirty(NetNumberOfDesktops);
 }
 
 void Ewmh::updateDesktopNames() {
-    vector<string> names;
-    for (auto tag : *tags_) {
-        names.push_back(tag->name);
-    }
-    X_.setPropertyString(X_.root(), netatom_[NetDesktopNames], names);
+    markDirty(NetDesktopNames);
 }
 
 void Ewmh::updateCurrentDesktop() {
-    HSTag* tag = get_current_monitor()->tag;
-    int index = tags_->index_of(tag);
-    if (index < 0) {
-        HSWarning("tag %s not found in internal list\n", tag->name->c_str());
+    markDirty(NetCurrentDesktop);
+}
+
+void Ewmh::markDirty(int netatomEnum) {
+    if (dirtyRootProperties_.test(netatomEnum)) {
+        skippedWrites_++;
+    }
+    dirtyRootProperties_.set(netatomEnum);
+}
+
+/** write all root window properties that were marked dirty since the last
+ * call. This is called once per main loop iteration such that every
+ * property is written at most once, no matter how often it was updated.
+ */
+void Ewmh::flushRootProperties() {
+    if (dirtyRootProperties_.none()) {
         return;
     }
-    X_.setPropertyCardinal(X_.root(), netatom_[NetCurrentDesktop], { index });
+    for (int i = 0; i < NetCOUNT; i++) {
+        if (dirtyRootProperties_.test(i)) {
+            writeRootProperty(i);
+        }
+    }
+    dirtyRootProperties_.reset();
+}
+
+//! return whether the value was already written to the given property and
+//! otherwise remember it as written
+template<typename T>
+bool Ewmh::isWritten(std::map<int, vector<T>>& written,
+                     int netatomEnum, const vector<T>& value)
+{
+    auto it = written.find(netatomEnum);
+    if (it != written.end() && it->second == value) {
+        skippedWrites_++;
+        return true;
+    }
+    written[netatomEnum] = value;
+    return false;
+}
+
+void Ewmh::writeRootProperty(int netatomEnum) {
+    switch (netatomEnum) {
+        case NetWmName: {
+            vector<string> name = { root_->settings->wmname() };
+            if (!isWritten(writtenStrings_, netatomEnum, name)) {
+                X_.setPropertyString(windowManagerWindow_, netatom_[NetWmName], name[0]);
+                X_.setPropertyString(X_.root(), netatom_[NetWmName], name[0]);
+            }
+            break;
+        }
+        case NetClientList: {
+            vector<Window> buf(netClientList_.begin(), netClientList_.end());
+            if (!isWritten(writtenWindows_, netatomEnum, buf)) {
+                X_.setPropertyWindow(X_.root(), netatom_[NetClientList], buf);
+            }
+            break;
+        }
+        case NetClientListStacking: {
+            // First: get the windows currently visible
+            vector<Window> buf;
+            auto addToVector = [&buf](Window w) { buf.push_back(w); };
+            g_monitors->extractWindowStack(true, addToVector);
+
+            // Then add all the invisible windows at the end
+            for (auto tag : *tags_) {
+                if (find_monitor_with_tag(tag)) {
+                // do not add tags because they are already added
+                    continue;
+                }
+                tag->stack->extractWindows(true, addToVector);
+            }
+
+            // reverse stacking order, because ewmh requires bottom to top order
+            std::reverse(buf.begin(), buf.end());
+
+            if (!isWritten(writtenWindows_, netatomEnum, buf)) {
+                X_.setPropertyWindow(X_.root(), netatom_[NetClientListStacking], buf);
+            }
+            break;
+        }
+        case NetNumberOfDesktops: {
+            vector<long> count = { (long) root_->tags->size() };
+            if (!isWritten(writtenCardinals_, netatomEnum, count)) {
+                X_.setPropertyCardinal(X_.root(), netatom_[NetNumberOfDesktops], count);
+            }
+            break;
+        }
+        case NetDesktopNames: {
+            vector<string> names;
+            for (auto tag : *tags_) {
+                names.push_back(tag->name);
+            }
+            if (!isWritten(writtenStrings_, netatomEnum, names)) {
+                X_.setPropertyString(X_.root(), netatom_[NetDesktopNames], names);
+            }
+            break;
+        }
+        case NetCurrentDesktop: {
+            HSTag* tag = get_current_monitor()->tag;
+            int index = tags_->index_of(tag);
+            if (index < 0) {
+                HSWarning("tag %s not found in internal list\n", tag->name->c_str());
+                break;
+            }
+            vector<long> value = { index };
+            if (!isWritten(writtenCardinals_, netatomEnum, value)) {
+                X_.setPropertyCardinal(X_.root(), netatom_[NetCurrentDesktop], value);
+            }
+            break;
+        }
+        case NetActiveWindow: {
+            vector<Window> value = { activeWindow_ };
+            if (!isWritten(writtenWindows_, netatomEnum, value)) {
+                X_.setPropertyWindow(X_.root(), netatom_[NetActiveWindow], value);
+            }
+            break;
+        }
+        default:
+            break;
+    }
 }
 
 void Ewmh::windowUpdateTag(Window win, HSTag* tag) {
@@ -257,7 +355,8 @@ void Ewmh::windowUpdateTag(Window win, HSTag* tag) {
 }
 
 void Ewmh::updateActiveWindow(Window win) {
-    X_.setPropertyWindow(X_.root(), netatom_[NetActiveWindow], { win });
+    activeWindow_ = win;
+    markDirty(NetActiveWindow);
 }
 
 bool Ewmh::focusStealingAllowed(long source) {
@@ -4,7 +4,11 @@
 #include <X11/X.h>
 #include <X11/Xlib.h>
 #include <array>
+#include <bitset>
+#include <list>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /* actions on NetWmState */
@@ -98,7 +102,7 @@ public:
         void print(FILE* file);
     };
 
-    enum class WM { Name, Protocols, Delete, State, TakeFocus, Last };
+    enum class WM { Name, Protocols, Delete, State, TakeFocus, WindowRole, Last };
 
     void injectDependencies(Root* root);
     void updateAll();
@@ -134,6 +138,10 @@ public:
 
     void setWindowOpacity(Window win, double opacity);
 
+    void flushRootProperties();
+    //! the number of root property writes that were coalesced or unnecessary
+    unsigned long skippedWrites() const { return skippedWrites_; }
+
     void windowUpdateWmState(Window win, WmState state);
 
     static Ewmh& get(); // temporary singleton getter
@@ -143,6 +151,7 @@ public:
 
     XConnection& X() { return X_; }
     Atom netatom(int netatomEnum);
+    Atom wmatom(WM proto);
     const char* netatomName(int netatomEnum);
 
 private:
@@ -152,11 +161,25 @@ private:
     XConnection& X_;
     InitialState initialState_;
     void readInitialEwmhState();
-    Atom wmatom(WM proto);
     Atom wmatom_[(int)WM::Last] = {};
 
-    //! array with Window-IDs in initial mapping order for _NET_CLIENT_LIST
-    std::vector<Window> netClientList_;
+    void markDirty(int netatomEnum);
+    void writeRootProperty(int netatomEnum);
+    template<typename T>
+    bool isWritten(std::map<int, std::vector<T>>& written,
+                   int netatomEnum, const std::vector<T>& value);
+
+    //! Window-IDs in initial mapping order for _NET_CLIENT_LIST
+    std::list<Window> netClientList_;
+    std::unordered_map<Window, std::list<Window>::iterator> netClientListPos_;
+    Window activeWindow_ = None;
+    //! root window properties that need to be written
+    std::bitset<NetCOUNT> dirtyRootProperties_;
+    //! the values last written to the root window properties
+    std::map<int, std::vector<Window>> writtenWindows_;
+    std::map<int, std::vector<long>> writtenCardinals_;
+    std::map<int, std::vector<std::string>> writtenStrings_;
+    unsigned long skippedWrites_ = 0;
     //! window that shows that the WM is still alive
     Window      windowManagerWindow_;
 
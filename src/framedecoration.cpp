@@ -15,39 +15,56 @@
 using std::shared_ptr;
 
 std::map<Window, FrameDecoration*> FrameDecoration::s_windowToFrameDecoration;
+std::vector<Window> FrameDecoration::s_windowPool;
 
 FrameDecoration::FrameDecoration(FrameLeaf& frame, HSTag* tag_, Settings* settings_)
     : frame_(frame)
+    , window(0)
     , visible(false)
     , window_transparent(false)
+    , slice(nullptr)
     , tag(tag_)
     , settings(settings_)
 {
-    // set window attributes
-    XSetWindowAttributes at;
-    at.background_pixel  = Color("red").toX11Pixel();
-    at.background_pixmap = ParentRelative;
-    at.override_redirect = True;
-    at.bit_gravity       = StaticGravity;
-    at.event_mask        = SubstructureRedirectMask|SubstructureNotifyMask
-         |ExposureMask|VisibilityChangeMask
-         |EnterWindowMask|LeaveWindowMask|FocusChangeMask
-         |ButtonPress;
-
-    window = XCreateWindow(g_display, g_root,
-                        42, 42, 42, 42, settings->frame_border_width(),
-                        DefaultDepth(g_display, DefaultScreen(g_display)),
-                        CopyFromParent,
-                        DefaultVisual(g_display, DefaultScreen(g_display)),
-                        CWOverrideRedirect | CWBackPixmap | CWEventMask, &at);
-
-    // set wm_class for window
-    XClassHint *hint = XAllocClassHint();
-    hint->res_name = (char*)HERBST_FRAME_CLASS;
-    hint->res_class = (char*)HERBST_FRAME_CLASS;
-    XSetClassHint(g_display, window, hint);
-
-    XFree(hint);
+}
+
+/**
+ * @brief Create the window of this decoration, or take one from the pool
+ * of windows of destroyed frame decorations. This happens on the first
+ * render() and not in the constructor, because many frames are never
+ * shown at all.
+ */
+void FrameDecoration::createWindow() {
+    if (!s_windowPool.empty()) {
+        window = s_windowPool.back();
+        s_windowPool.pop_back();
+    } else {
+        // set window attributes
+        XSetWindowAttributes at;
+        at.background_pixel  = Color("red").toX11Pixel();
+        at.background_pixmap = ParentRelative;
+        at.override_redirect = True;
+        at.bit_gravity       = StaticGravity;
+        at.event_mask        = SubstructureRedirectMask|SubstructureNotifyMask
+             |ExposureMask|VisibilityChangeMask
+             |EnterWindowMask|LeaveWindowMask|FocusChangeMask
+             |ButtonPress;
+
+        window = XCreateWindow(g_display, g_root,
+                            42, 42, 42, 42, settings->frame_border_width(),
+                            DefaultDepth(g_display, DefaultScreen(g_display)),
+                            CopyFromParent,
+                            DefaultVisual(g_display, DefaultScreen(g_display)),
+                            CWOverrideRedirect | CWBackPixmap | CWEventMask, &at);
+
+        // set wm_class for window
+        XClassHint *hint = XAllocClassHint();
+        hint->res_name = (char*)HERBST_FRAME_CLASS;
+        hint->res_class = (char*)HERBST_FRAME_CLASS;
+        XSetClassHint(g_display, window, hint);
+
+        XFree(hint);
+    }
 
     // insert into static map
     s_windowToFrameDecoration[window] = this;
@@ -58,27 +75,76 @@ FrameDecoration::FrameDecoration(FrameLeaf& frame, HSTag* tag_, Settings* settin
 }
 
 FrameDecoration::~FrameDecoration() {
+    if (!window) {
+        return;
+    }
     // remove from map
     auto it = s_windowToFrameDecoration.find(window);
     HSWeakAssert(it != s_windowToFrameDecoration.end());
     s_windowToFrameDecoration.erase(it);
 
-    XDestroyWindow(g_display, window);
     tag->stack->removeSlice(slice);
     delete slice;
+
+    if (s_windowPool.size() < s_windowPoolSize) {
+        // keep the window for the next frame decoration. All of its
+        // properties are set again by render(), except for the mask and
+        // the visibility
+        if (visible) {
+            XUnmapWindow(g_display, window);
+        }
+        if (window_transparent) {
+            window_make_intransparent(window);
+        }
+        s_windowPool.push_back(window);
+    } else {
+        XDestroyWindow(g_display, window);
+    }
+}
+
+bool FrameDecoration::RenderState::operator==(const RenderState& other) const
+{
+    return geometry == other.geometry
+        && borderWidth == other.borderWidth
+        && borderColor == other.borderColor
+        && bgColor == other.bgColor
+        && innerWidth == other.innerWidth
+        && innerColor == other.innerColor
+        && transparent == other.transparent
+        && transparentWidth == other.transparentWidth
+        && opacity == other.opacity;
 }
 
 void FrameDecoration::render(const FrameDecorationData& data, bool isFocused) {
-    unsigned long border_color = settings->frame_border_normal_color->toX11Pixel();
-    unsigned long bg_color = settings->frame_bg_normal_color->toX11Pixel();
-    int bw = settings->frame_border_width();
+    RenderState state;
+    state.geometry = data.geometry;
+    state.borderColor = settings->frame_border_normal_color->toX11Pixel();
+    state.bgColor = settings->frame_bg_normal_color->toX11Pixel();
+    state.borderWidth = settings->frame_border_width();
+    state.opacity = settings->frame_normal_opacity();
     if (isFocused) {
-        border_color = settings->frame_border_active_color->toX11Pixel();
-        bg_color = settings->frame_bg_active_color->toX11Pixel();
+        state.borderColor = settings->frame_border_active_color->toX11Pixel();
+        state.bgColor = settings->frame_bg_active_color->toX11Pixel();
+        state.opacity = settings->frame_active_opacity();
     }
     if (settings->smart_frame_surroundings() && !data.hasParent) {
-        bw = 0;
+        state.borderWidth = 0;
+    }
+    state.innerWidth = settings->frame_border_inner_width();
+    state.innerColor = settings->frame_border_inner_color->toX11Pixel();
+    state.transparent = settings->frame_bg_transparent();
+    state.transparentWidth = settings->frame_transparent_width();
+    if (rendered_ && state == lastRender_) {
+        // the window already looks like this
+        return;
     }
+    if (!window) {
+        createWindow();
+    }
+    rendered_ = true;
+    lastRender_ = state;
+
+    int bw = state.borderWidth;
     Rectangle rect = data.geometry;
     XSetWindowBorderWidth(g_display, window, bw);
     XMoveResizeWindow(g_display, window,
@@ -86,29 +152,23 @@ void FrameDecoration::render(const FrameDecorationData& data, bool isFocused) {
                       rect.y - bw,
                       rect.width, rect.height);
 
-    if (settings->frame_border_inner_width() > 0
-        && settings->frame_border_inner_width() < settings->frame_border_width()) {
+    if (state.innerWidth > 0 && state.innerWidth < settings->frame_border_width()) {
         set_window_double_border(g_display, window,
-                settings->frame_border_inner_width(),
-                settings->frame_border_inner_color->toX11Pixel(),
-                border_color);
+                rect.width, rect.height, bw, state.innerWidth,
+                state.innerColor, state.borderColor);
     } else {
-        XSetWindowBorder(g_display, window, border_color);
+        XSetWindowBorder(g_display, window, state.borderColor);
     }
 
-    XSetWindowBackground(g_display, window, bg_color);
-    if (settings->frame_bg_transparent()) {
+    XSetWindowBackground(g_display, window, state.bgColor);
+    if (state.transparent) {
         window_cut_rect_hole(window, rect.width, rect.height,
-                             settings->frame_transparent_width());
+                             state.transparentWidth);
     } else if (window_transparent) {
-        window_make_intransparent(window, rect.width, rect.height);
-    }
-    window_transparent = settings->frame_bg_transparent();
-    if (isFocused) {
-        Ewmh::get().setWindowOpacity(window, settings->frame_active_opacity()/100.0);
-    } else {
-        Ewmh::get().setWindowOpacity(window, settings->frame_normal_opacity()/100.0);
+        window_make_intransparent(window);
     }
+    window_transparent = state.transparent;
+    Ewmh::get().setWindowOpacity(window, state.opacity/100.0);
 
     XClearWindow(g_display, window);
 }
@@ -118,7 +178,7 @@ void FrameDecoration::updateVisibility(const FrameDecorationData& data, bool isF
     bool show = settings->always_show_frame()
               || data.hasClients
               || isFocused;
-    if (show != visible) {
+    if (show != visible && window) {
         visible = show;
         if (visible) {
             XMapWindow(g_display, window);
@@ -4,6 +4,7 @@
 #include <X11/X.h>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "x11-types.h"
 
@@ -33,7 +34,26 @@ public:
     static FrameDecoration* withWindow(Window winid);
 
 private:
+    void createWindow();
+    // everything that determines the X requests issued by render()
+    struct RenderState {
+        Rectangle geometry;
+        int borderWidth = 0;
+        unsigned long borderColor = 0;
+        unsigned long bgColor = 0;
+        int innerWidth = 0;
+        unsigned long innerColor = 0;
+        bool transparent = false;
+        int transparentWidth = 0;
+        int opacity = 0;
+        bool operator==(const RenderState& other) const;
+    };
+    bool rendered_ = false;
+    RenderState lastRender_;
     static std::map<Window, FrameDecoration*> s_windowToFrameDecoration;
+    //! windows of destroyed frame decorations, for reuse
+    static std::vector<Window> s_windowPool;
+    static const size_t s_windowPoolSize = 64;
     FrameLeaf& frame_; //! the owner of this decoration
     Window window;
     bool visible; // whether the window is visible at the moment
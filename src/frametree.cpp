@@ -228,6 +228,7 @@ int FrameTree::rotateCommand() {
                     s->fraction_ = FixPrecDec::fromInteger(1) - s->fraction_;
                     break;
             }
+            s->invalidateLayout();
         };
     void (*onLeaf)(FrameLeaf*) =
         [] (FrameLeaf*) {
@@ -304,7 +305,8 @@ void FrameTree::prettyPrint(shared_ptr<Frame> frame, Output output) {
 shared_ptr<FrameLeaf> FrameTree::findEmptyFrameNearFocusGeometrically(shared_ptr<Frame> subtree)
 {
     // render frame geometries.
-    TilingResult tileres = subtree->computeLayout({0, 0, 800, 800});
+    TilingResult tileres;
+    subtree->computeLayout({0, 0, 800, 800}, tileres);
     function<Rectangle(shared_ptr<FrameLeaf>)> frame2geometry =
             [tileres] (shared_ptr<FrameLeaf> frame) -> Rectangle {
         for (auto& framedata : tileres.frames) {
@@ -369,16 +371,18 @@ shared_ptr<FrameLeaf> FrameTree::findEmptyFrameNearFocus(shared_ptr<Frame> subtr
 }
 
 shared_ptr<FrameLeaf> FrameTree::findFrameWithClient(Client* client) {
-    shared_ptr<FrameLeaf> frame = {};
-    root_->fmap(
-        [](FrameSplit*) {},
-        [&](FrameLeaf* l) {
-            auto& cs = l->clients;
-            if (std::find(cs.begin(), cs.end(), client) != cs.end()) {
-                frame = l->thisLeaf();
-            }
-        });
-    return frame;
+    // every FrameLeaf maintains the back-pointer of its clients
+    auto frame = client->frameLeaf_.lock();
+    if (frame && contains(frame)) {
+        return frame;
+    }
+    return {};
+}
+
+//! remove the client from the frame that contains it
+bool FrameTree::removeClient(Client* client) {
+    auto frame = findFrameWithClient(client);
+    return frame && frame->removeClient(client);
 }
 
 bool FrameTree::contains(shared_ptr<Frame> frame) const
@@ -427,6 +431,7 @@ bool FrameTree::focusClient(Client* client) {
     auto& cs = frameLeaf->clients;
     int index = std::find(cs.begin(), cs.end(), client) - cs.begin();
     frameLeaf->selection = index;
+    frameLeaf->invalidateLayout();
     // 2. make the frame focused
     focusFrame(frameLeaf);
     return true;
@@ -443,6 +448,7 @@ void FrameTree::focusFrame(shared_ptr<Frame> frame) {
         } else {
             parent->selection_ = 1;
         }
+        parent->invalidateLayout();
         frame = parent;
     }
 }
@@ -584,7 +590,7 @@ int FrameTree::cycleFrameCommand(Input input, Output output) {
         return HERBST_INVALID_ARGUMENT;
     }
     cycle_frame(delta);
-    get_current_monitor()->applyLayout();
+    get_current_monitor()->applyFocusChange();
     return 0;
 }
 
@@ -664,7 +670,7 @@ void FrameTree::applyFrameTree(shared_ptr<Frame> target,
         // this might even involve the above targetLeaf / targetSplit
         // so we need to do this before everything else
         for (const auto& client : sourceLeaf->clients) {
-            client->tag()->frame->root_->removeClient(client);
+            client->tag()->frame->removeClient(client);
             if (client->tag() != tag_) {
                 client->tag()->stack->removeSlice(client->slice);
                 client->setTag(tag_);
@@ -688,9 +694,10 @@ void FrameTree::applyFrameTree(shared_ptr<Frame> target,
             targetSplit = {};
         }
         // make the targetLeaf look like the sourceLeaf
-        targetLeaf->clients = clients;
+        targetLeaf->setClients(clients);
         targetLeaf->setSelection(sourceLeaf->selection);
         targetLeaf->layout = sourceLeaf->layout;
+        targetLeaf->invalidateLayout();
     } else {
         // assert that target is a FrameSplit
         if (targetLeaf) {
@@ -703,6 +710,7 @@ void FrameTree::applyFrameTree(shared_ptr<Frame> target,
         targetSplit->align_ = sourceSplit->align_;
         targetSplit->fraction_ = sourceSplit->fraction_;
         targetSplit->selection_ = sourceSplit->selection_;
+        targetSplit->invalidateLayout();
         applyFrameTree(targetSplit->a_, sourceSplit->a_);
         applyFrameTree(targetSplit->b_, sourceSplit->b_);
     }
@@ -717,6 +725,7 @@ void FrameTree::replaceNode(shared_ptr<Frame> old,
         rootLink_ = root_.get();
         // root frame should never have a parent:
         root_->parent_ = {};
+        root_->invalidateLayout();
     } else {
         parent->replaceChild(old, replacement);
     }
@@ -40,6 +40,7 @@ public:
     bool focusInDirection(Direction dir, bool externalOnly);
     //! return a frame in the tree that holds the client
     std::shared_ptr<FrameLeaf> findFrameWithClient(Client* client);
+    bool removeClient(Client* client);
 
     //! check whether the present FrameTree contains a given Frame
     //! (it requires that there are no cycles in the 'tree' containing the Frame
@@ -39,6 +39,54 @@ Frame::Frame(HSTag* tag, Settings* settings, weak_ptr<FrameSplit> parent)
 {}
 Frame::~Frame() = default;
 
+Frame::LayoutSettings::LayoutSettings(Settings* settings)
+    : frameGap(settings->frame_gap())
+    , frameBorderWidth(settings->frame_border_width())
+    , framePadding(settings->frame_padding())
+    , windowGap(settings->window_gap())
+    , smartFrameSurroundings(settings->smart_frame_surroundings())
+    , smartWindowSurroundings(settings->smart_window_surroundings())
+    , gaplessGrid(settings->gapless_grid())
+{
+}
+
+bool Frame::LayoutSettings::operator==(const LayoutSettings& other) const
+{
+    return frameGap == other.frameGap
+        && frameBorderWidth == other.frameBorderWidth
+        && framePadding == other.framePadding
+        && windowGap == other.windowGap
+        && smartFrameSurroundings == other.smartFrameSurroundings
+        && smartWindowSurroundings == other.smartWindowSurroundings
+        && gaplessGrid == other.gaplessGrid;
+}
+
+void Frame::computeLayout(Rectangle rect, TilingResult& output)
+{
+    LayoutSettings layoutSettings(settings_);
+    if (layoutDirty_
+        || !(rect == layoutCacheRect_)
+        || !(layoutSettings == layoutCacheSettings_))
+    {
+        // the cache keeps its memory, so usually this does not allocate
+        layoutCache_.clear();
+        computeLayoutUncached(rect, layoutCache_);
+        layoutCacheRect_ = rect;
+        layoutCacheSettings_ = layoutSettings;
+        layoutDirty_ = false;
+    }
+    output.mergeFrom(layoutCache_);
+}
+
+void Frame::invalidateLayout()
+{
+    layoutDirty_ = true;
+    auto parent = parent_.lock();
+    if (parent) {
+        parent->invalidateLayout();
+    }
+}
+
 FrameLeaf::FrameLeaf(HSTag* tag, Settings* settings, weak_ptr<FrameSplit> parent)
     : Frame(tag, settings, parent)
     , client_count_(this, "client_count", [this]() {return clientCount(); })
@@ -77,27 +125,24 @@ void FrameLeaf::insertClient(Client* client, bool focus) {
     // insert it after the selection
     int index = std::min((selection + 1), (int)clients.size());
     clients.insert(clients.begin() + index, client);
+    adoptClient(client);
     if (focus) {
         selection = index;
     }
+    invalidateLayout();
     // FRAMETODO: if we we are focused, and were empty before, we have to focus
     // the client now
 }
 
-shared_ptr<FrameLeaf> FrameSplit::frameWithClient(Client* client) {
-    auto found = a_->frameWithClient(client);
-    if (found) {
-        return found;
-    } else {
-        return b_->frameWithClient(client);
-    }
+//! set the client's back-pointer to this frame
+void FrameLeaf::adoptClient(Client* client) {
+    client->frameLeaf_ = thisLeaf();
 }
 
-shared_ptr<FrameLeaf> FrameLeaf::frameWithClient(Client* client) {
-    if (find(clients.begin(), clients.end(), client) != clients.end()) {
-        return thisLeaf();
-    } else {
-        return shared_ptr<FrameLeaf>();
+//! reset the client's back-pointer, unless it was moved to another frame already
+void FrameLeaf::releaseClient(Client* client) {
+    if (client->frameLeaf_.lock().get() == this) {
+        client->frameLeaf_.reset();
     }
 }
 
@@ -106,6 +151,7 @@ bool FrameLeaf::removeClient(Client* client) {
     if (it != clients.end()) {
         auto idx = it - clients.begin();
         clients.erase(it);
+        releaseClient(client);
         // find out new selection
         // if selection was before removed window
         // then do nothing
@@ -113,6 +159,7 @@ bool FrameLeaf::removeClient(Client* client) {
         selection -= (selection < idx) ? 0 : 1;
         // ensure valid index
         selection = std::max(std::min(selection, ((int)clients.size()) - 1), 0);
+        invalidateLayout();
         return true;
     } else {
         return false;
@@ -175,8 +222,7 @@ string Frame::frameIndex() const
     }
 }
 
-TilingResult FrameLeaf::layoutLinear(Rectangle rect, bool vertical) {
-    TilingResult res;
+void FrameLeaf::layoutLinear(Rectangle rect, bool vertical, TilingResult& res) {
     auto cur = rect;
     int last_step_y;
     int last_step_x;
@@ -208,11 +254,9 @@ TilingResult FrameLeaf::layoutLinear(Rectangle rect, bool vertical) {
         cur.x += step_x;
         i++;
     }
-    return res;
 }
 
-TilingResult FrameLeaf::layoutMax(Rectangle rect) {
-    TilingResult res;
+void FrameLeaf::layoutMax(Rectangle rect, TilingResult& res) {
     // go through all clients from top to bottom and remember
     // whether they are still visible. The stacking order is such that
     // the windows at the end of 'clients' are on top of the windows
@@ -231,7 +275,6 @@ TilingResult FrameLeaf::layoutMax(Rectangle rect) {
         }
         res.add(client, step);
     }
-    return res;
 }
 
 void frame_layout_grid_get_size(size_t count, int* res_rows, int* res_cols) {
@@ -247,10 +290,9 @@ void frame_layout_grid_get_size(size_t count, int* res_rows, int* res_cols) {
     }
 }
 
-TilingResult FrameLeaf::layoutGrid(Rectangle rect) {
-    TilingResult res;
+void FrameLeaf::layoutGrid(Rectangle rect, TilingResult& res) {
     if (clients.empty()) {
-        return res;
+        return;
     }
 
     int rows, cols;
@@ -286,10 +328,9 @@ TilingResult FrameLeaf::layoutGrid(Rectangle rect) {
         }
         cur.y += height;
     }
-    return res;
 }
 
-TilingResult FrameLeaf::computeLayout(Rectangle rect) {
+void FrameLeaf::computeLayoutUncached(Rectangle rect, TilingResult& res) {
     last_rect = rect;
     if (!settings_->smart_frame_surroundings() || parent_.lock()) {
         // apply frame gap
@@ -306,7 +347,6 @@ TilingResult FrameLeaf::computeLayout(Rectangle rect) {
     rect.height = std::max(WINDOW_MIN_HEIGHT, rect.height);
 
     // move windows
-    TilingResult res;
     FrameDecorationData frame_data;
     frame_data.geometry = rect;
     frame_data.visible = true;
@@ -315,7 +355,7 @@ TilingResult FrameLeaf::computeLayout(Rectangle rect) {
     res.focused_frame = decoration;
     res.add(decoration, frame_data);
     if (clients.empty()) {
-        return res;
+        return;
     }
     // whether we should omit the gap around windows:
     bool smart_window_surroundings_active =
@@ -344,39 +384,36 @@ TilingResult FrameLeaf::computeLayout(Rectangle rect) {
         rect.width  -= frame_padding * 2;
         rect.height -= frame_padding * 2;
     }
-    TilingResult layoutResult;
+    size_t firstClient = res.data.size();
     switch (layout) {
         case LayoutAlgorithm::max:
-            layoutResult = layoutMax(rect);
+            layoutMax(rect, res);
             break;
         case LayoutAlgorithm::grid:
-            layoutResult = layoutGrid(rect);
+            layoutGrid(rect, res);
             break;
         case LayoutAlgorithm::vertical:
-            layoutResult = layoutVertical(rect);
+            layoutVertical(rect, res);
             break;
         case LayoutAlgorithm::horizontal:
-            layoutResult = layoutHorizontal(rect);
+            layoutHorizontal(rect, res);
             break;
     }
-    if (smart_window_surroundings_active) {
-        for (auto& it : layoutResult.data) {
-            it.second.minimalDecoration = true;
-        }
-    } else {
-        // apply window gap: deduct 'window_gap' many pixels from
-        // bottom and right of every window:
-        for (auto& it : layoutResult.data) {
-            it.second.geometry.width -= window_gap;
-            it.second.geometry.height -= window_gap;
+    for (size_t i = firstClient; i < res.data.size(); i++) {
+        auto& step = res.data[i].second;
+        if (smart_window_surroundings_active) {
+            step.minimalDecoration = true;
+        } else {
+            // apply window gap: deduct 'window_gap' many pixels from
+            // bottom and right of every window:
+            step.geometry.width -= window_gap;
+            step.geometry.height -= window_gap;
         }
     }
-    res.mergeFrom(layoutResult);
     res.focus = clients[selection];
-    return res;
 }
 
-TilingResult FrameSplit::computeLayout(Rectangle rect) {
+void FrameSplit::computeLayoutUncached(Rectangle rect, TilingResult& res) {
     last_rect = rect;
     auto first = rect;
     auto second = rect;
@@ -389,14 +426,14 @@ TilingResult FrameSplit::computeLayout(Rectangle rect) {
         second.x += first.width;
         second.width -= first.width;
     }
-    TilingResult res;
-    auto res1 = a_->computeLayout(first);
-    auto res2 = b_->computeLayout(second);
-    res.mergeFrom(res1);
-    res.mergeFrom(res2);
-    res.focus = (selection_ == 0) ? res1.focus : res2.focus;
-    res.focused_frame = (selection_ == 0) ? res1.focused_frame : res2.focused_frame;
-    return res;
+    a_->computeLayout(first, res);
+    auto focus1 = res.focus;
+    auto focusedFrame1 = res.focused_frame;
+    b_->computeLayout(second, res);
+    if (selection_ == 0) {
+        res.focus = focus1;
+        res.focused_frame = focusedFrame1;
+    }
 }
 
 void FrameSplit::fmap(function<void(FrameSplit*)> onSplit, function<void(FrameLeaf*)> onLeaf, int order) {
@@ -445,7 +482,7 @@ int frame_current_bring(int argc, char** argv, Output output) {
     }
     HSTag* tag = get_current_monitor()->tag;
     global_tags->moveClient(client, tag, {}, true);
-    auto frame = tag->frame->root_->frameWithClient(client);
+    auto frame = tag->frame->findFrameWithClient(client);
     if (!client->is_client_floated() && !frame->isFocused()) {
         frame->removeClient(client);
         tag->frame->focusedFrame()->insertClient(client, true);
@@ -462,8 +499,9 @@ void FrameLeaf::setSelection(int index) {
         index = clients.size() - 1;
     }
     selection = index;
+    invalidateLayout();
     clients[selection]->window_focus();
-    get_current_monitor()->applyLayout();
+    get_current_monitor()->applyFocusChange();
 }
 
 int Frame::splitsToRoot(SplitAlign align) {
@@ -513,11 +551,30 @@ void FrameSplit::replaceChild(shared_ptr<Frame> old, shared_ptr<Frame> newchild)
         newchild->parent_ = thisSplit();
         bLink_ = b_.get();
     }
+    // the new child might have been the root before, or vice versa
+    newchild->invalidateLayout();
+    old->invalidateLayout();
 }
 
 void FrameLeaf::addClients(const vector<Client*>& vec, bool atFront) {
     auto targetPosition = atFront ? clients.begin() : clients.end();
     clients.insert(targetPosition, vec.begin(), vec.end());
+    for (auto client : vec) {
+        adoptClient(client);
+    }
+    invalidateLayout();
+}
+
+//! replace the clients of this frame by the given ones
+void FrameLeaf::setClients(const vector<Client*>& vec) {
+    for (auto client : clients) {
+        releaseClient(client);
+    }
+    clients = vec;
+    for (auto client : clients) {
+        adoptClient(client);
+    }
+    invalidateLayout();
 }
 
 bool FrameLeaf::split(SplitAlign alignment, FixPrecDec fraction, size_t childrenLeaving) {
@@ -541,6 +598,7 @@ bool FrameLeaf::split(SplitAlign alignment, FixPrecDec fraction, size_t children
         second->setSelection(selection - childrenStaying);
         selection = std::max(0, childrenStaying - 1);
     }
+    invalidateLayout();
     return true;
 }
 
@@ -549,16 +607,19 @@ void FrameSplit::swapChildren() {
     swap(a_,b_);
     aLink_ = a_.get();
     bLink_ = b_.get();
+    invalidateLayout();
 }
 
 void FrameSplit::adjustFraction(FixPrecDec delta) {
     fraction_ = fraction_ + delta;
     fraction_ = clampFraction(fraction_);
+    invalidateLayout();
 }
 
 void FrameSplit::setFraction(FixPrecDec fraction)
 {
     fraction_ = clampFraction(fraction);
+    invalidateLayout();
 }
 
 FixPrecDec FrameSplit::clampFraction(FixPrecDec fraction)
@@ -698,6 +759,7 @@ int FrameLeaf::getInnerNeighbourIndex(Direction direction) {
 void FrameLeaf::moveClient(int new_index) {
     swap(clients[new_index], clients[selection]);
     selection = new_index;
+    invalidateLayout();
 }
 
 int frame_move_window_command(int argc, char** argv, Output output) {
@@ -740,8 +802,9 @@ int frame_move_window_command(int argc, char** argv, Output output) {
         if (client && neighbour) { // if neighbour was found
             // move window to neighbour
             frame->removeClient(client);
-            FrameTree::focusedFrame(neighbour)->insertClient(client);
-            neighbour->frameWithClient(client)->select(client);
+            auto target = FrameTree::focusedFrame(neighbour);
+            target->insertClient(client);
+            target->select(client);
 
             // change selection in parent
             shared_ptr<FrameSplit> parent = neighbour->getParent();
@@ -762,6 +825,7 @@ void FrameLeaf::select(Client* client) {
     auto it = find(clients.begin(), clients.end(), client);
     if (it != clients.end()) {
         selection = it - clients.begin();
+        invalidateLayout();
     }
 }
 
@@ -843,7 +907,11 @@ void Frame::setVisibleRecursive(bool visible) {
 vector<Client*> FrameLeaf::removeAllClients() {
     vector<Client*> result;
     swap(result, clients);
+    for (auto client : result) {
+        releaseClient(client);
+    }
     selection = 0;
+    invalidateLayout();
     return result;
 }
 
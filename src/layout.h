@@ -29,11 +29,17 @@ protected:
     Frame(HSTag* tag, Settings* settings, std::weak_ptr<FrameSplit> parent);
     virtual ~Frame();
 public:
-    virtual std::shared_ptr<FrameLeaf> frameWithClient(Client* client) = 0;
     virtual bool removeClient(Client* client) = 0;
 
     virtual bool isFocused();
-    virtual TilingResult computeLayout(Rectangle rect) = 0;
+    /*! compute the layout of this subtree and append it to output. The
+     * result is cached, and only recomputed if the subtree was modified since
+     * (see invalidateLayout()) or if rect or the relevant settings differ
+     * from the last call.
+     */
+    void computeLayout(Rectangle rect, TilingResult& output);
+    //! mark the cached layout of this frame and of its ancestors as outdated
+    void invalidateLayout();
     virtual Client* focusedClient() = 0;
 
     // do recursive for each element of the (binary) frame tree
@@ -86,12 +92,33 @@ public: // soon will be protected:
     virtual std::shared_ptr<FrameSplit> isSplit() { return std::shared_ptr<FrameSplit>(); };
     virtual std::shared_ptr<FrameLeaf> isLeaf() { return std::shared_ptr<FrameLeaf>(); };
 protected:
+    //! compute the layout of this subtree into the empty 'output'
+    virtual void computeLayoutUncached(Rectangle rect, TilingResult& output) = 0;
     void foreachClient(ClientAction action);
     HSTag* tag_;
     Settings* settings_;
     std::weak_ptr<FrameSplit> parent_;
     Rectangle  last_rect; // last rectangle when being drawn
                           // this is only used for 'split explode'
+private:
+    //! the settings the layout of a frame depends on
+    class LayoutSettings {
+    public:
+        LayoutSettings() = default;
+        LayoutSettings(Settings* settings);
+        bool operator==(const LayoutSettings& other) const;
+        int frameGap = 0;
+        int frameBorderWidth = 0;
+        int framePadding = 0;
+        int windowGap = 0;
+        bool smartFrameSurroundings = false;
+        bool smartWindowSurroundings = false;
+        bool gaplessGrid = false;
+    };
+    bool layoutDirty_ = true;
+    Rectangle layoutCacheRect_ = {};
+    LayoutSettings layoutCacheSettings_;
+    TilingResult layoutCache_;
 };
 
 class FrameLeaf : public Frame, public FrameDataLeaf {
@@ -101,12 +128,9 @@ public:
 
     // inherited:
     void insertClient(Client* client, bool focus = false);
-    std::shared_ptr<FrameLeaf> frameWithClient(Client* client) override;
     bool removeClient(Client* client) override;
     void moveClient(int new_index);
 
-    TilingResult computeLayout(Rectangle rect) override;
-
     virtual void fmap(std::function<void(FrameSplit*)> onSplit,
                       std::function<void(FrameLeaf*)> onLeaf, int order) override;
 
@@ -115,13 +139,14 @@ public:
     void setSelection(int index);
     void select(Client* client);
     void addClients(const std::vector<Client*>& vec, bool atFront = false);
+    void setClients(const std::vector<Client*>& vec);
 
 
     Client* focusedClient() override;
 
     bool split(SplitAlign alignment, FixPrecDec fraction, size_t childrenLeaving = 0);
     LayoutAlgorithm getLayout() { return layout; }
-    void setLayout(LayoutAlgorithm l) { layout = l; }
+    void setLayout(LayoutAlgorithm l) { layout = l; invalidateLayout(); }
     int getSelection() { return selection; }
     size_t clientCount() { return clients.size(); }
     std::shared_ptr<Frame> neighbour(Direction direction);
@@ -136,14 +161,19 @@ public:
     DynAttribute_<int> client_count_;
     DynAttribute_<int> selectionAttr_;
     DynAttribute_<LayoutAlgorithm> algorithmAttr_;
+protected:
+    void computeLayoutUncached(Rectangle rect, TilingResult& output) override;
 private:
     friend class FrameTree;
-    // layout algorithms
-    TilingResult layoutLinear(Rectangle rect, bool vertical);
-    TilingResult layoutHorizontal(Rectangle rect) { return layoutLinear(rect, false); };
-    TilingResult layoutVertical(Rectangle rect) { return layoutLinear(rect, true); };
-    TilingResult layoutMax(Rectangle rect);
-    TilingResult layoutGrid(Rectangle rect);
+    // layout algorithms, each appending the clients to res
+    void layoutLinear(Rectangle rect, bool vertical, TilingResult& res);
+    void layoutHorizontal(Rectangle rect, TilingResult& res) { layoutLinear(rect, false, res); };
+    void layoutVertical(Rectangle rect, TilingResult& res) { layoutLinear(rect, true, res); };
+    void layoutMax(Rectangle rect, TilingResult& res);
+    void layoutGrid(Rectangle rect, TilingResult& res);
+
+    void adoptClient(Client* client);
+    void releaseClient(Client* client);
 
     // members
     FrameDecoration* decoration;
@@ -155,11 +185,8 @@ public:
                  std::shared_ptr<Frame> a_, std::shared_ptr<Frame> b_);
     ~FrameSplit() override;
     // inherited:
-    std::shared_ptr<FrameLeaf> frameWithClient(Client* client) override;
     bool removeClient(Client* client) override;
 
-    TilingResult computeLayout(Rectangle rect) override;
-
     virtual void fmap(std::function<void(FrameSplit*)> onSplit,
                       std::function<void(FrameLeaf*)> onLeaf, int order) override;
 
@@ -180,13 +207,15 @@ public:
     std::shared_ptr<FrameSplit> thisSplit();
     std::shared_ptr<FrameSplit> isSplit() override { return thisSplit(); }
     SplitAlign getAlign() { return align_; }
-    void swapSelection() { selection_ = selection_ == 0 ? 1 : 0; }
-    void setSelection(int s) { selection_ = s; }
+    void swapSelection() { selection_ = selection_ == 0 ? 1 : 0; invalidateLayout(); }
+    void setSelection(int s) { selection_ = s; invalidateLayout(); }
     DynAttribute_<SplitAlign> splitTypeAttr_;
     DynAttribute_<FixPrecDec> fractionAttr_;
     DynAttribute_<int> selectionAttr_;
     Link_<Frame> aLink_;
     Link_<Frame> bLink_;
+protected:
+    void computeLayoutUncached(Rectangle rect, TilingResult& output) override;
 private:
     friend class FrameTree;
 };
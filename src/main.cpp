@@ -28,6 +28,7 @@
 #include "rootcommands.h"
 #include "rulemanager.h"
 #include "settings.h"
+#include "stack.h"
 #include "tagmanager.h"
 #include "tmp.h"
 #include "utils.h"
@@ -170,7 +171,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                    &RuleManager::unruleCompletion}},
         {"apply_rules",    {clients, &ClientManager::applyRulesCmd,
                                      &ClientManager::applyRulesCompletion}},
-        {"list_rules",     {rules, &RuleManager::listRulesCommand }},
+        {"list_rules",     {rules, &RuleManager::listRulesCommand,
+                                   &RuleManager::listRulesCompletion}},
         {"layout",         tags->frameCommand(&FrameTree::dumpLayoutCommand, &FrameTree::dumpLayoutCompletion)},
         {"stack",          { monitors, &MonitorManager::stackCommand }},
         {"dump",           tags->frameCommand(&FrameTree::dumpLayoutCommand, &FrameTree::dumpLayoutCompletion)},
@@ -218,6 +220,8 @@ unique_ptr<CommandTable> commands(shared_ptr<Root> root) {
                                             &RootCommands::get_attr_complete }},
         {"set_attr",       { root_commands, &RootCommands::set_attr_cmd,
                                             &RootCommands::set_attr_complete }},
+        {"set_attrs",      { root_commands, &RootCommands::set_attrs_cmd,
+                                            &RootCommands::set_attrs_complete }},
         {"attr",           { root_commands, &RootCommands::attr_cmd,
                                             &RootCommands::attr_complete }},
         {"mktemp",         { tmp, &Tmp::mktemp,
@@ -356,7 +360,7 @@ int raise_command(int argc, char** argv, Output output) {
     } else {
         auto window = get_window(argv[1]);
         if (window) {
-            XRaiseWindow(g_display, window);
+            WindowStacking::get().raise(window);
         } else {
             output << argv[0] << ": Could not find client \"" << argv[1] << "\".\n";
             return HERBST_INVALID_ARGUMENT;
@@ -63,6 +63,7 @@ Monitor::Monitor(Settings* settings_, MonitorManager* monman_, Rectangle rect_,
 }
 
 Monitor::~Monitor() {
+    WindowStacking::get().forget(stacking_window);
     XDestroyWindow(g_display, stacking_window);
 }
 
@@ -129,12 +130,8 @@ bool Monitor::setTag(HSTag* new_tag) {
     return owner == this;
 }
 
-void Monitor::applyLayout() {
-    if (settings->monitors_locked) {
-        dirty = true;
-        return;
-    }
-    dirty = false;
+//! compute the TilingResult for the current tag of this monitor
+void Monitor::computeTilingResult(TilingResult& res) {
     Rectangle cur_rect = rect;
     // apply pad
     // FIXME: why does the following + work for attributes pad_* ?
@@ -149,8 +146,7 @@ void Monitor::applyLayout() {
         cur_rect.height -= settings->frame_gap();
         cur_rect.width -= settings->frame_gap();
     }
-    bool isFocused = get_current_monitor() == this;
-    TilingResult res = tag->frame->root_->computeLayout(cur_rect);
+    tag->frame->root_->computeLayout(cur_rect, res);
     if (tag->floating_focused) {
         res.focus = tag->focusedClient();
     }
@@ -176,6 +172,34 @@ void Monitor::applyLayout() {
             }
         }
     }
+}
+
+//! update the geometry and decoration of a client in the TilingResult
+void Monitor::applyTilingStep(Client* c, const TilingStep& step, bool clientFocused) {
+    if (c->fullscreen_()) {
+        c->resize_fullscreen(rect, clientFocused);
+    } else if (step.floated) {
+        c->resize_floating(this, clientFocused);
+    } else {
+        bool minDec = step.minimalDecoration;
+        c->resize_tiling(step.geometry, clientFocused, minDec);
+    }
+}
+
+void Monitor::applyLayout() {
+    if (settings->monitors_locked) {
+        dirty = true;
+        lastLayoutValid_ = false;
+        return;
+    }
+    dirty = false;
+    unsigned long pass = ++layoutPasses_;
+    bool isFocused = get_current_monitor() == this;
+    // reuse the memory of the previous pass. If this is a nested call,
+    // then layoutBuffer_ is just empty.
+    TilingResult res;
+    std::swap(res, layoutBuffer_);
+    computeTilingResult(res);
     // 1. Update stack (TODO: why stack first?)
     for (auto& p : res.data) {
         Client* c = p.first;
@@ -201,37 +225,12 @@ void Monitor::applyLayout() {
             }
         }
     }
-    tag->stack->clearLayer(LAYER_FOCUS);
-    if (isFocused && res.focus) {
-        // activate the focus layer if requested by the setting
-        // or if there is a fullscreen client potentially covering
-        // the focused client.
-        // Also activate raise on focus in tiling mode to make the decoration
-        // of the focused window look better. If we don't raise it
-        // (temporarily), then the shadow of another window can
-        // cover the decoration of the focused client. To avoid that
-        // the decoration of the focused window is covered by the shadow
-        // of an unfocused window,
-        // we raise the focused window. Without shadows, this has no effect.
-        if (g_settings->raise_on_focus_temporarily()
-            || tag->stack->isLayerEmpty(LAYER_FULLSCREEN) == false)
-        {
-            tag->stack->sliceAddLayer(res.focus->slice, LAYER_FOCUS);
-        }
-    }
+    updateFocusLayer(res.focus, isFocused);
     restack();
     // 2. Update window geometries
     for (auto& p : res.data) {
         Client* c = p.first;
-        bool clientFocused = isFocused && res.focus == c;
-        if (c->fullscreen_()) {
-            c->resize_fullscreen(rect, clientFocused);
-        } else if (p.second.floated) {
-            c->resize_floating(this, clientFocused);
-        } else {
-            bool minDec = p.second.minimalDecoration;
-            c->resize_tiling(p.second.geometry, clientFocused, minDec);
-        }
+        applyTilingStep(c, p.second, isFocused && res.focus == c);
     }
     for (auto& c : tag->floating_clients_) {
         if (c->fullscreen_()) {
@@ -250,6 +249,38 @@ void Monitor::applyLayout() {
             p.first->updateVisibility(p.second, p.first == res.focused_frame && isFocused);
         }
     }
+    finishLayoutPass(res, isFocused, pass);
+}
+
+//! activate the focus layer for the focused client if necessary
+void Monitor::updateFocusLayer(Client* focus, bool isFocused) {
+    tag->stack->clearLayer(LAYER_FOCUS);
+    if (isFocused && focus) {
+        // activate the focus layer if requested by the setting
+        // or if there is a fullscreen client potentially covering
+        // the focused client.
+        // Also activate raise on focus in tiling mode to make the decoration
+        // of the focused window look better. If we don't raise it
+        // (temporarily), then the shadow of another window can
+        // cover the decoration of the focused client. To avoid that
+        // the decoration of the focused window is covered by the shadow
+        // of an unfocused window,
+        // we raise the focused window. Without shadows, this has no effect.
+        if (g_settings->raise_on_focus_temporarily()
+            || tag->stack->isLayerEmpty(LAYER_FULLSCREEN) == false)
+        {
+            tag->stack->sliceAddLayer(focus->slice, LAYER_FOCUS);
+        }
+    }
+}
+
+//! the common end of applyLayout() and applyFocusChange()
+void Monitor::finishLayoutPass(TilingResult& res, bool isFocused, unsigned long pass) {
+    // send the geometry and decoration updates of all clients at once
+    // instead of waiting for a round trip per client. X errors caused by
+    // these requests are reported asynchronously by XConnection::xerror()
+    // with their serial number.
+    XFlush(g_display);
     if (isFocused) {
         if (res.focus) {
             Root::get()->clients()->focus = res.focus;
@@ -263,6 +294,83 @@ void Monitor::applyLayout() {
     // remove all enternotify-events from the event queue that were
     // generated while arranging the clients on this monitor
     monman->dropEnterNotifyEvents.emit();
+    // remember what is on the screen now, unless another layout pass
+    // started in the meantime
+    lastLayoutValid_ = pass == layoutPasses_;
+    if (lastLayoutValid_) {
+        lastLayoutTag_ = tag;
+        lastLayoutFocused_ = isFocused;
+        std::swap(res, lastLayout_);
+    }
+    res.clear();
+    std::swap(res, layoutBuffer_);
+}
+
+/**
+ * @brief Update the monitor after only the focus changed on its tag. If
+ * this does not affect the layout, then only the decorations of the
+ * previously and the newly focused client and frame are updated. Otherwise,
+ * this is the same as applyLayout().
+ */
+void Monitor::applyFocusChange() {
+    bool isFocused = get_current_monitor() == this;
+    if (settings->monitors_locked || dirty || !lastLayoutValid_
+        || lastLayoutTag_ != tag || lastLayoutFocused_ != isFocused)
+    {
+        applyLayout();
+        return;
+    }
+    unsigned long pass = ++layoutPasses_;
+    TilingResult res;
+    std::swap(res, layoutBuffer_);
+    computeTilingResult(res);
+    if (!res.sameLayout(lastLayout_)) {
+        // e.g. in the max layout, the focus decides which client is visible
+        res.clear();
+        std::swap(res, layoutBuffer_);
+        applyLayout();
+        return;
+    }
+    Client* oldFocus = lastLayout_.focus;
+    FrameDecoration* oldFocusedFrame = lastLayout_.focused_frame;
+    // the stack
+    if (isFocused && res.focus && !res.focus->is_client_floated()) {
+        res.focus->raise();
+    }
+    updateFocusLayer(res.focus, isFocused);
+    restack();
+    // the decorations of the clients whose focus state changed
+    for (Client* c : {oldFocus, res.focus}) {
+        if (!c || (c == oldFocus && c == res.focus)) {
+            continue;
+        }
+        bool clientFocused = isFocused && res.focus == c;
+        auto it = std::find_if(res.data.begin(), res.data.end(),
+            [c](const std::pair<Client*,TilingStep>& p) { return p.first == c; });
+        if (it != res.data.end()) {
+            applyTilingStep(c, it->second, clientFocused);
+            continue;
+        }
+        auto& floating = tag->floating_clients_;
+        if (std::find(floating.begin(), floating.end(), c) != floating.end()) {
+            if (c->fullscreen_()) {
+                c->resize_fullscreen(rect, clientFocused);
+            } else {
+                c->resize_floating(this, clientFocused);
+            }
+        }
+        // otherwise, the client is not on this tag anymore
+    }
+    // the decorations of the frames whose focus state changed
+    if (!tag->floating && oldFocusedFrame != res.focused_frame) {
+        for (auto& p : res.frames) {
+            if (p.first == oldFocusedFrame || p.first == res.focused_frame) {
+                p.first->render(p.second, p.first == res.focused_frame && isFocused);
+                p.first->updateVisibility(p.second, p.first == res.focused_frame && isFocused);
+            }
+        }
+    }
+    finishLayoutPass(res, isFocused, pass);
 }
 
 Monitor* find_monitor_by_name(const char* name) {
@@ -676,16 +784,16 @@ void Monitor::restack() {
     Window fullscreenFocus = 0;
     /* don't add a focused fullscreen client to the stack because
      * we want a focused fullscreen window to be above the panels which are
-     * usually unmanaged. All the windows passed to the XRestackWindows
+     * usually unmanaged. All the windows restacked below the stacking_window
      * will end up below all unmanaged windows, so don't add a focused
      * fullscreen window to it. Instead raise the fullscreen window
      * manually such that it is above the panel */
     Client* client = tag->focusedClient();
     if (client && client->fullscreen_) {
         fullscreenFocus = client->decorationWindow();
-        XRaiseWindow(g_display, fullscreenFocus);
+        WindowStacking::get().raise(fullscreenFocus);
     }
-    // collect all other windows in a vector and pass it to XRestackWindows
+    // collect all other windows in a vector and restack them
     vector<Window> buf = { stacking_window };
     auto addToVector = [&buf, fullscreenFocus](Window w) {
         if (w != fullscreenFocus) {
@@ -693,7 +801,7 @@ void Monitor::restack() {
         }
     };
     tag->stack->extractWindows(false, addToVector);
-    XRestackWindows(g_display, buf.data(), buf.size());
+    WindowStacking::get().restack(buf);
 }
 
 int shift_to_monitor(int argc, char** argv, Output output) {
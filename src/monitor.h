@@ -6,6 +6,7 @@
 #include "attribute_.h"
 #include "object.h"
 #include "rules.h"
+#include "tilingresult.h"
 #include "x11-types.h"
 
 class HSTag;
@@ -54,6 +55,7 @@ public:
     void renameComplete(Completion& complete);
     bool setTag(HSTag* new_tag);
     void applyLayout();
+    void applyFocusChange();
     void restack();
     std::string getDescription();
     void evaluateClientPlacement(Client* client, ClientPlacement placement) const;
@@ -62,6 +64,19 @@ private:
     std::string setTagString(std::string new_tag);
     Settings* settings;
     MonitorManager* monman;
+    void computeTilingResult(TilingResult& res);
+    void applyTilingStep(Client* c, const TilingStep& step, bool clientFocused);
+    void updateFocusLayer(Client* focus, bool isFocused);
+    void finishLayoutPass(TilingResult& res, bool isFocused, unsigned long pass);
+    //! the memory for the TilingResult in applyLayout()
+    TilingResult layoutBuffer_;
+    //! the TilingResult of the last completed layout pass
+    TilingResult lastLayout_;
+    bool lastLayoutValid_ = false;
+    HSTag* lastLayoutTag_ = nullptr;
+    bool lastLayoutFocused_ = false;
+    //! the number of layout passes started so far
+    unsigned long layoutPasses_ = 0;
 };
 
 // adds a new monitor to the monitors list and returns a pointer to it
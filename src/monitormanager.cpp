@@ -273,6 +273,14 @@ void MonitorManager::relayoutTag(HSTag* tag)
     }
 }
 
+void MonitorManager::updateFocusOnTag(HSTag* tag)
+{
+    Monitor* m = byTag(tag);
+    if (m) {
+        m->applyFocusChange();
+    }
+}
+
 void MonitorManager::relayoutAll()
 {
     for (Monitor* m : *this) {
@@ -488,7 +496,7 @@ void MonitorManager::extractWindowStack(bool real_clients, function<void(Window)
 void MonitorManager::restack() {
     vector<Window> buf;
     extractWindowStack(false, [&buf](Window w) { buf.push_back(w); });
-    XRestackWindows(g_display, buf.data(), buf.size());
+    WindowStacking::get().restack(buf);
     Ewmh::get().updateClientListStacking();
 }
 
@@ -523,10 +531,10 @@ int MonitorManager::stackCommand(Output output) {
     for (Monitor* monitor : monitorStack_) {
         vector<shared_ptr<StringTree>> layers;
         for (size_t layerIdx = 0; layerIdx < LAYER_COUNT; layerIdx++) {
-            auto layer = monitor->tag->stack->layers_[layerIdx];
+            const auto& layer = monitor->tag->stack->layers_[layerIdx];
 
             vector<shared_ptr<StringTree>> slices;
-            for (auto& slice : layer) {
+            for (auto slice : layer) {
                 slices.push_back(make_shared<StringTree>(slice->getLabel()));
             }
 
@@ -53,6 +53,7 @@ public:
     CommandBinding tagCommand(std::function<int(HSTag&)> cmd);
     // relayout the monitor showing this tag, if there is any
     void relayoutTag(HSTag* tag);
+    void updateFocusOnTag(HSTag* tag);
     void relayoutAll();
     int removeMonitor(Input input, Output output);
     void removeMonitor(Monitor* monitor);
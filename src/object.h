@@ -45,7 +45,7 @@ public:
 
     void addAttribute(Attribute* a);
     void removeAttribute(Attribute* a);
-    std::map<std::string, Attribute*> attributes() { return attribs_; }
+    const std::map<std::string, Attribute*>& attributes() { return attribs_; }
 
     // if a concrete object maintains its index within the parent as an
     // attribute (e.g. monitors and tags do), then they should implement the
@@ -1,7 +1,43 @@
 #include "regexstr.h"
 
+#include <regex.h>
+#include <stdexcept>
+
 using std::string;
 
+class RegexStr::Compiled {
+public:
+    //! may throw std::invalid_argument exception
+    Compiled(const string& source) {
+        int status = regcomp(&regex_, source.c_str(), REG_EXTENDED);
+        if (status != 0) {
+            char buf[256];
+            regerror(status, &regex_, buf, sizeof(buf));
+            throw std::invalid_argument(buf);
+        }
+    }
+    ~Compiled() {
+        regfree(&regex_);
+    }
+    Compiled(const Compiled&) = delete;
+    Compiled& operator=(const Compiled&) = delete;
+
+    bool matchesEntirely(const string& str) const {
+        // The regex is not anchored, because wrapping it in "^(...)$" breaks
+        // sources with an unmatched ')' (which regcomp() accepts) and shifts
+        // back-references. Since regexec() reports the leftmost-longest
+        // match, the regex matches entirely iff this match spans the string.
+        regmatch_t match[1];
+        if (0 != regexec(&regex_, str.c_str(), 1, match, 0)) {
+            return false;
+        }
+        return match[0].rm_so == 0
+            && match[0].rm_eo == static_cast<regoff_t>(str.size());
+    }
+private:
+    regex_t regex_;
+};
+
 RegexStr::RegexStr()
 {
 }
@@ -15,11 +51,7 @@ RegexStr RegexStr::fromStr(const string& source)
     // https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/V1_chap09.html#tag_09_05_03
     // => So we must not compile "" to a regex
     if (!source.empty()) {
-        try {
-            r.regex_ = std::regex(source, std::regex::extended);
-        }  catch (const std::exception& e) {
-            throw std::invalid_argument(e.what());
-        }
+        r.compiled_ = std::make_shared<const Compiled>(source);
     }
     return r;
 }
@@ -34,8 +66,143 @@ bool RegexStr::matches(const string& str) const
     if (source_.empty()) {
         return false;
     } else {
-        return std::regex_match(str, regex_);
+        return compiled_->matchesEntirely(str);
+    }
+}
+
+void RegexSet::insert(const RegexStr& regex)
+{
+    auto it = regexes_.find(regex.str());
+    if (it != regexes_.end()) {
+        it->second.second++;
+        return;
+    }
+    regexes_.insert({regex.str(), { regex, 1 }});
+    unionUpToDate_ = false;
+}
+
+void RegexSet::erase(const RegexStr& regex)
+{
+    auto it = regexes_.find(regex.str());
+    if (it == regexes_.end()) {
+        return;
+    }
+    it->second.second--;
+    if (it->second.second == 0) {
+        regexes_.erase(it);
+        unionUpToDate_ = false;
+    }
+}
+
+/**
+ * @brief Check whether a regex can be used as an alternative of a larger
+ * regex without changing its meaning: all parentheses must be balanced
+ * (an unmatched ')' is a literal) and there must be no back-references
+ * (their numbers change in the alternation)
+ */
+static bool isSelfContained(const string& source)
+{
+    size_t depth = 0;
+    for (size_t i = 0; i < source.size(); i++) {
+        char c = source[i];
+        if (c == '\\') {
+            i++;
+            if (i < source.size() && source[i] >= '1' && source[i] <= '9') {
+                return false;
+            }
+        } else if (c == '[') {
+            // skip the bracket expression, in which ']' is literal
+            // if it comes first
+            i++;
+            if (i < source.size() && source[i] == '^') {
+                i++;
+            }
+            if (i < source.size() && source[i] == ']') {
+                i++;
+            }
+            while (i < source.size() && source[i] != ']') {
+                if (source[i] == '[' && i + 1 < source.size()
+                    && (source[i + 1] == ':' || source[i + 1] == '.'
+                        || source[i + 1] == '='))
+                {
+                    // skip "[:class:]", "[.coll.]" and "[=equiv=]"
+                    char delim = source[i + 1];
+                    size_t end = source.find(string(1, delim) + "]", i + 2);
+                    if (end == string::npos) {
+                        return false;
+                    }
+                    i = end + 1;
+                }
+                i++;
+            }
+            if (i >= source.size()) {
+                return false;
+            }
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')') {
+            if (depth == 0) {
+                return false;
+            }
+            depth--;
+        }
+    }
+    return depth == 0;
+}
+
+std::set<string> RegexSet::matching(const string& str) const
+{
+    std::set<string> result;
+    if (str.empty() && regexes_.count("")) {
+        result.insert("");
+    }
+    if (!unionUpToDate_) {
+        string source;
+        for (const auto& it : regexes_) {
+            if (it.first.empty()) {
+                continue;
+            }
+            if (!isSelfContained(it.first)) {
+                // the alternation would not mean what it should
+                source = "";
+                break;
+            }
+            source += (source.empty() ? "(" : "|(") + it.first + ")";
+        }
+        try {
+            union_ = RegexStr::fromStr(source);
+        } catch (const std::invalid_argument&) {
+            // fall back to matching the regexes one by one
+            union_ = {};
+        }
+        unionUpToDate_ = true;
+    }
+    if (union_.empty()) {
+        for (const auto& it : regexes_) {
+            if (it.second.first.matches(str)) {
+                result.insert(it.first);
+            }
+        }
+        return result;
+    }
+    if (!union_.matches(str)) {
+        return result;
+    }
+    // at least one of the non-empty regexes matches, so if none of the
+    // others did, the last one does without trying it
+    size_t remaining = regexes_.size() - regexes_.count("");
+    bool found = false;
+    for (const auto& it : regexes_) {
+        if (it.first.empty()) {
+            continue;
+        }
+        remaining--;
+        if ((remaining == 0 && !found) || it.second.first.matches(str)) {
+            result.insert(it.first);
+            found = true;
+        }
     }
+    return result;
 }
 
 template<> RegexStr Converter<RegexStr>::parse(const string& source) {
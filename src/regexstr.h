@@ -1,13 +1,19 @@
 #ifndef REGEXSTR_H
 #define REGEXSTR_H
 
-#include <regex>
+#include <map>
+#include <memory>
+#include <set>
 
 #include "attribute_.h"
 #include "types.h"
 
 /** wrapper class for extended regexes that remembers
  * its source string
+ *
+ * The regex engine is an implementation detail of regexstr.cpp: currently,
+ * the POSIX regcomp()/regexec() from the C library is used, which is
+ * considerably faster than std::regex from libstdc++.
  */
 class RegexStr
 {
@@ -28,10 +34,37 @@ public:
      */
     bool operator==(const RegexStr& other) const;
     bool operator!=(const RegexStr& o) const { return ! operator==(o); }
+    //! whether the regex matches the entire string
     bool matches(const std::string& str) const;
 private:
+    class Compiled;
     std::string source_;
-    std::regex regex_;
+    //! the compiled regex, shared among copies, because it is immutable
+    std::shared_ptr<const Compiled> compiled_;
+};
+
+/** A multiset of regexes that are matched against a string at once.
+ *
+ * All regexes are combined into one, such that only a single pass over the
+ * string is needed in the common case that none of them matches. In
+ * contrast to RegexStr, the empty regex "" matches the empty string.
+ */
+class RegexSet
+{
+public:
+    void insert(const RegexStr& regex);
+    //! remove one occurrence of the regex
+    void erase(const RegexStr& regex);
+    bool empty() const { return regexes_.empty(); }
+    //! the sources of all regexes that match the entire string
+    std::set<std::string> matching(const std::string& str) const;
+private:
+    //! the distinct regexes by their source, with their multiplicity
+    std::map<std::string, std::pair<RegexStr, size_t>> regexes_;
+    //! the alternation of all non-empty regexes, built on demand.
+    //! It stays empty if it could not be built.
+    mutable RegexStr union_;
+    mutable bool unionUpToDate_ = false;
 };
 
 template<> RegexStr Converter<RegexStr>::parse(const std::string& source);
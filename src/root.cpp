@@ -42,6 +42,7 @@ Root::Root(Globals g, XConnection& xconnection, IpcServer& ipcServer)
     , ipcServer_(ipcServer)
     , panels(make_unique<PanelManager>(xconnection))
     , ewmh(make_unique<Ewmh>(xconnection))
+    , ewmhSkippedWrites_(this, "ewmh_skipped_writes", &Root::ewmhSkippedWrites)
 {
     // initialize root children (alphabetically)
     clients.init();
@@ -71,6 +72,7 @@ Root::Root(Globals g, XConnection& xconnection, IpcServer& ipcServer)
     // connect slots
     clients->needsRelayout.connect(monitors(), &MonitorManager::relayoutTag);
     tags->needsRelayout_.connect(monitors(), &MonitorManager::relayoutTag);
+    tags->focusChanged_.connect(monitors(), &MonitorManager::updateFocusOnTag);
     clients->floatingStateChanged.connect([](Client* c) {
         c->tag()->applyFloatingState(c);
     });
@@ -117,3 +119,7 @@ HlwmCommon Root::common() {
     return HlwmCommon(Root::get().get());
 }
 
+unsigned long Root::ewmhSkippedWrites() const
+{
+    return ewmh->skippedWrites();
+}
@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include "attribute_.h"
 #include "child.h"
 #include "object.h"
 
@@ -66,9 +67,11 @@ public:
     // automatically from the signals emitted by ClientManager, etc
     std::unique_ptr<PanelManager> panels; // Using "pimpl" to avoid include
     std::unique_ptr<Ewmh> ewmh; // Using "pimpl" to avoid include
+    DynAttribute_<unsigned long> ewmhSkippedWrites_;
 
     // global actions
     void focusFrame(std::shared_ptr<FrameLeaf> frameToFocus);
+    unsigned long ewmhSkippedWrites() const;
 
 private:
     static std::shared_ptr<Root> root_;
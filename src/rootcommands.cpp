@@ -64,6 +64,78 @@ int RootCommands::set_attr_cmd(Input in, Output output) {
     }
 }
 
+/** set multiple attributes at once: first check that all new values are
+ * acceptable and only then write them. While writing, the monitors are
+ * locked, such that all the relayouts caused by the attribute changes
+ * are collapsed into a single one.
+ */
+int RootCommands::set_attrs_cmd(Input in, Output output) {
+    vector<pair<Attribute*, string>> changes;
+    string path, new_value;
+    while (in >> path) {
+        if (!(in >> new_value)) {
+            return HERBST_NEED_MORE_ARGS;
+        }
+        Attribute* a = getAttribute(path, output);
+        if (!a) {
+            return HERBST_INVALID_ARGUMENT;
+        }
+        string error_message = a->checkValue(new_value);
+        if (!error_message.empty()) {
+            output << in.command() << ": \""
+                << new_value << "\" is not a valid value for "
+                << a->name() << ": "
+                << error_message << endl;
+            return HERBST_INVALID_ARGUMENT;
+        }
+        changes.push_back({a, new_value});
+    }
+    if (changes.empty()) {
+        return HERBST_NEED_MORE_ARGS;
+    }
+    changeLockLevel(1);
+    // the old values, for rolling back if a setter rejects a value
+    vector<pair<Attribute*, string>> oldValues;
+    int status = 0;
+    for (const auto& change : changes) {
+        Attribute* a = change.first;
+        oldValues.push_back({a, a->str()});
+        string error_message = a->change(change.second);
+        if (!error_message.empty()) {
+            output << in.command() << ": \""
+                << change.second << "\" is not a valid value for "
+                << a->name() << ": "
+                << error_message << endl;
+            status = HERBST_INVALID_ARGUMENT;
+            break;
+        }
+    }
+    if (status != 0) {
+        // restore in reverse order
+        for (auto it = oldValues.rbegin(); it != oldValues.rend(); it++) {
+            it->first->change(it->second);
+        }
+    }
+    changeLockLevel(-1);
+    return status;
+}
+
+/** lock (delta = 1) or unlock (delta = -1) the monitors. This goes
+ * through the object tree such that we do not depend on the MonitorManager
+ */
+void RootCommands::changeLockLevel(int delta) {
+    Attribute* lock = root.deepAttribute("settings.monitors_locked");
+    if (!lock) {
+        return;
+    }
+    try {
+        int level = Converter<int>::parse(lock->str());
+        lock->change(Converter<int>::str(std::max(0, level + delta)));
+    } catch (const std::exception&) {
+        // leave the lock level untouched
+    }
+}
+
 int RootCommands::attr_cmd(Input in, Output output) {
     string path = "", new_value = "";
     in >> path >> new_value;
@@ -271,22 +343,42 @@ RootCommands::FormatString RootCommands::parseFormatString(const string &format)
     return blobs;
 }
 
+/** parse a format string or throw an exception, just as
+ * parseFormatString(), but only parse every format string once. The returned
+ * reference is valid until the next call of cachedFormatString().
+ */
+const RootCommands::FormatString& RootCommands::cachedFormatString(const string& format)
+{
+    auto it = parsedFormats_.find(format);
+    if (it != parsedFormats_.end()) {
+        return it->second;
+    }
+    FormatString parsed = parseFormatString(format); // throws
+    // the format strings are user input, so avoid unbounded growth
+    const size_t maxCacheSize = 128;
+    if (parsedFormats_.size() >= maxCacheSize) {
+        parsedFormats_.clear();
+    }
+    return parsedFormats_[format] = parsed;
+}
+
 int RootCommands::sprintf_cmd(Input input, Output output)
 {
     string ident, formatStringSrc;
     if (!(input >> ident >> formatStringSrc)) {
         return HERBST_NEED_MORE_ARGS;
     }
-    FormatString format;
+    const FormatString* format;
     try {
-        format = parseFormatString(formatStringSrc);
+        format = &cachedFormatString(formatStringSrc);
     }  catch (const std::invalid_argument& e) {
         output << input.command() << ": " << e.what() << endl;
         return HERBST_INVALID_ARGUMENT;
     }
     // evaluate placeholders in the format string
     string replacedString = "";
-    for (const auto& blob : format) {
+    replacedString.reserve(formatStringSrc.size());
+    for (const auto& blob : *format) {
         if (blob.literal_) {
             replacedString += blob.data_;
         } else if (blob.data_ == "c") {
@@ -322,15 +414,15 @@ void RootCommands::sprintf_complete(Completion& complete)
     } else if (complete == 1) {
         // no completion for format string
     } else {
-        FormatString fs;
+        const FormatString* fs;
         try {
-            fs = parseFormatString(complete[1]);
+            fs = &cachedFormatString(complete[1]);
         }  catch (const std::invalid_argument&) {
             complete.invalidArguments();
             return;
         }
         int indexOfNextArgument = 2;
-        for (const auto& b : fs) {
+        for (const auto& b : *fs) {
             if (b.literal_ == true) {
                 continue;
             }
@@ -618,15 +710,17 @@ void RootCommands::completeObjectPath(Completion& complete, bool attributes,
         return;
     }
     if (attributes) {
-        for (auto& it : object->attributes()) {
-            if (attributeFilter && !attributeFilter(it.second)) {
+        auto range = complete.candidates(object->attributes(), objectPath);
+        for (auto it = range.first; it != range.second; it++) {
+            if (attributeFilter && !attributeFilter(it->second)) {
                 continue;
             }
-            complete.full(objectPath + it.first);
+            complete.full(objectPath + it->first);
         }
     }
-    for (auto& it : object->children()) {
-        complete.partial(objectPath + it.first + OBJECT_PATH_SEPARATOR);
+    auto range = complete.candidates(object->children(), objectPath);
+    for (auto it = range.first; it != range.second; it++) {
+        complete.partial(objectPath + it->first + OBJECT_PATH_SEPARATOR);
     }
 }
 
@@ -656,6 +750,18 @@ void RootCommands::set_attr_complete(Completion& complete) {
     }
 }
 
+void RootCommands::set_attrs_complete(Completion& complete) {
+    if (complete.needleIndex() % 2 == 0) {
+        completeObjectPath(complete, true,
+            [](Attribute* a) { return a->writeable(); } );
+    } else {
+        Attribute* a = root.deepAttribute(complete[complete.needleIndex() - 1]);
+        if (a) {
+            a->complete(complete);
+        }
+    }
+}
+
 void RootCommands::attr_complete(Completion& complete)
 {
     if (complete == 0) {
@@ -805,7 +911,6 @@ void RootCommands::completeEnvName(Completion& complete) {
 
 int RootCommands::chainCommand(Input input, Output output)
 {
-    vector<vector<string>> commands = splitCommandList(input.toVector());
     int returnCode = 0;
     // the condition that has to be fulfilled if we want to continue
     // execuding commands. the default (for 'chain') is to always continue
@@ -819,16 +924,26 @@ int RootCommands::chainCommand(Input input, Output output)
         // continue executing commands while they are failing
         conditionContinue = [](int code) { return code >= 1; };
     }
-    for (auto& cmd : commands) {
-        if (cmd.empty()) {
-            // if command range is empty, do nothing
-            continue;
+    string separator;
+    if (!(input >> separator)) {
+        return returnCode;
+    }
+    // the commands are the ranges between the separators. They
+    // share the arguments with 'input' instead of copying them.
+    auto cmdBegin = input.begin();
+    while (true) {
+        auto cmdEnd = std::find(cmdBegin, input.end(), separator);
+        // if command range is empty, do nothing
+        if (cmdBegin != cmdEnd) {
+            returnCode = Commands::call(input.slice(cmdBegin, cmdEnd), output);
+            if (!conditionContinue(returnCode)) {
+                break;
+            }
         }
-        Input cmdinput = Input(cmd[0], cmd.begin() + 1, cmd.end());
-        returnCode = Commands::call(cmdinput, output);
-        if (!conditionContinue(returnCode)) {
+        if (cmdEnd == input.end()) {
             break;
         }
+        cmdBegin = cmdEnd + 1;
     }
     return returnCode;
 }
@@ -851,23 +966,3 @@ void RootCommands::chainCompletion(Completion& complete)
     }
 }
 
-
-vector<vector<string>> RootCommands::splitCommandList(ArgList::Container input) {
-    vector<vector<string>> res;
-    if (input.empty()) {
-        return res;
-    }
-    vector<string> current;
-    string separator = input[0];
-    for (size_t i = 1; i < input.size(); i++) {
-        if (input[i] == separator) {
-            res.push_back(current);
-            current = {};
-        } else {
-            current.push_back(input[i]);
-        }
-    }
-    res.push_back(current);
-    return res;
-}
-
@@ -5,6 +5,7 @@
  * but modify the global state */
 
 #include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -35,6 +36,8 @@ public:
     void get_attr_complete(Completion& complete);
     int set_attr_cmd(Input in, Output output);
     void set_attr_complete(Completion& complete);
+    int set_attrs_cmd(Input in, Output output);
+    void set_attrs_complete(Completion& complete);
     int attr_cmd(Input in, Output output);
     void attr_complete(Completion& complete);
     int print_object_tree_command(Input in, Output output);
@@ -77,8 +80,9 @@ public:
     int chainCommand(Input input, Output output);
     void chainCompletion(Completion& complete);
 
-    std::vector<std::vector<std::string>> splitCommandList(ArgList::Container input);
 private:
+    void changeLockLevel(int delta);
+
     Object& root;
     std::vector<std::unique_ptr<Attribute>> userAttributes_;
 
@@ -89,6 +93,11 @@ private:
     };
     typedef std::vector<FormatStringBlob> FormatString;
     FormatString parseFormatString(const std::string& format);
+    const FormatString& cachedFormatString(const std::string& format);
+    //! format strings that have already been parsed. Commands like sprintf
+    //! are typically called with the same few format strings over and over
+    //! again (from keybindings, panels, etc.)
+    std::map<std::string, FormatString> parsedFormats_;
 };
 
 
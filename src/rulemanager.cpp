@@ -1,5 +1,8 @@
 #include "rulemanager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <set>
 #include <string>
 
 #include "completion.h"
@@ -15,7 +18,8 @@ using std::endl;
  * Implements the "rule" IPC command
  */
 int RuleManager::addRuleCommand(Input input, Output output) {
-    Rule rule;
+    auto newRule = make_unique<Rule>();
+    Rule& rule = *newRule;
 
     // Assign default label (index will be incremented if adding the rule
     // actually succeeds)
@@ -26,6 +30,7 @@ int RuleManager::addRuleCommand(Input input, Output output) {
         {"once", false},
         {"printlabel", false},
         {"prepend", false},
+        {"reapply", false},
     };
 
     for (auto argIter = input.begin(); argIter != input.end(); argIter++) {
@@ -102,6 +107,7 @@ int RuleManager::addRuleCommand(Input input, Output output) {
 
     // Store "once" flag in rule
     rule.once = ruleFlags["once"];
+    rule.reapply = ruleFlags["reapply"];
 
     // Comply with "printlabel" flag
     if (ruleFlags["printlabel"]) {
@@ -109,12 +115,17 @@ int RuleManager::addRuleCommand(Input input, Output output) {
     }
 
     // At this point, adding the rule will be successful, so increment the
-    // label index (as it says in the docs):
+    // label index (as it says in the docs). Also use it as the name in the
+    // object tree, because in contrast to the label, it is unique.
+    rule.objectName = to_string(rule_label_index_);
     rule_label_index_++;
 
     // Insert rule into list according to "prepend" flag
     auto insertAt = ruleFlags["prepend"] ? rules_.begin() : rules_.end();
-    rules_.insert(insertAt, make_unique<Rule>(rule));
+    rule.position = ruleFlags["prepend"] ? nextPositionFront_-- : nextPositionBack_++;
+    addChild(newRule.get(), rule.objectName);
+    addToIndex(newRule.get());
+    rules_.insert(insertAt, std::move(newRule));
 
     return HERBST_EXIT_SUCCESS;
 }
@@ -129,8 +140,17 @@ int RuleManager::unruleCommand(Input input, Output output) {
     }
 
     if (arg == "--all" || arg == "-F") {
+        for (auto& rule : rules_) {
+            removeChild(rule->objectName);
+        }
         rules_.clear();
+        ruleIndex_.clear();
+        unindexedRules_.clear();
+        regexSets_.clear();
+        reapplyRules_.clear();
         rule_label_index_ = 0;
+        nextPositionFront_ = -1;
+        nextPositionBack_ = 0;
     } else {
         // Remove rule specified by argument
         auto removedCount = removeRules(arg);
@@ -146,14 +166,41 @@ int RuleManager::unruleCommand(Input input, Output output) {
 /*!
  * Implements the "list_rules" IPC command
  */
-int RuleManager::listRulesCommand(Output output) {
+int RuleManager::listRulesCommand(Input input, Output output) {
+    string arg;
+    if (!(input >> arg)) {
+        for (auto& rule : rules_) {
+            rule->print(output);
+        }
+        return HERBST_EXIT_SUCCESS;
+    }
+    if (arg != "--stats") {
+        output << input.command() << ": Unknown argument \"" << arg << "\"\n";
+        return HERBST_INVALID_ARGUMENT;
+    }
+    // the most expensive rules first
+    std::vector<Rule*> rules;
     for (auto& rule : rules_) {
-        rule->print(output);
+        rules.push_back(rule.get());
+    }
+    std::stable_sort(rules.begin(), rules.end(),
+                     [](const Rule* a, const Rule* b) {
+                         return a->evaluationTime() > b->evaluationTime();
+                     });
+    for (Rule* rule : rules) {
+        rule->printStats(output);
     }
-
     return HERBST_EXIT_SUCCESS;
 }
 
+void RuleManager::listRulesCompletion(Completion& complete) {
+    if (complete == 0) {
+        complete.full("--stats");
+    } else {
+        complete.none();
+    }
+}
+
 /*!
  * Removes all rules with the given label
  *
@@ -164,6 +211,8 @@ size_t RuleManager::removeRules(string label) {
 
     for (auto ruleIter = rules_.begin(); ruleIter != rules_.end();) {
         if ((*ruleIter)->label == label) {
+            removeChild((*ruleIter)->objectName);
+            removeFromIndex(ruleIter->get());
             ruleIter = rules_.erase(ruleIter);
         } else {
             ruleIter++;
@@ -175,6 +224,74 @@ size_t RuleManager::removeRules(string label) {
     return countAfter - countBefore;
 }
 
+//! Removes the given rule from the list and the index, and deletes it
+void RuleManager::removeRule(Rule* rule) {
+    removeChild(rule->objectName);
+    removeFromIndex(rule);
+    rules_.remove_if([rule](const std::unique_ptr<Rule>& r) {
+        return r.get() == rule;
+    });
+}
+
+void RuleManager::addToIndex(Rule* rule) {
+    for (const auto& regexCond : rule->conditions) {
+        if (regexCond.isBulkRegex()) {
+            regexSets_[regexCond.name].insert(regexCond.value_reg_exp);
+        }
+    }
+    if (rule->reapply) {
+        for (const auto& property : rule->dependencies()) {
+            reapplyRules_[property].push_back(rule);
+        }
+    }
+    const Condition* cond = rule->indexCondition();
+    if (cond) {
+        ruleIndex_[cond->name][cond->value_str].push_back(rule);
+    } else {
+        unindexedRules_.push_back(rule);
+    }
+}
+
+void RuleManager::removeFromIndex(Rule* rule) {
+    auto eraseFrom = [rule](std::vector<Rule*>& rules) {
+        rules.erase(std::remove(rules.begin(), rules.end(), rule), rules.end());
+    };
+    for (const auto& regexCond : rule->conditions) {
+        if (regexCond.isBulkRegex()) {
+            auto& regexSet = regexSets_[regexCond.name];
+            regexSet.erase(regexCond.value_reg_exp);
+            if (regexSet.empty()) {
+                regexSets_.erase(regexCond.name);
+            }
+        }
+    }
+    if (rule->reapply) {
+        for (const auto& property : rule->dependencies()) {
+            auto& rules = reapplyRules_[property];
+            eraseFrom(rules);
+            if (rules.empty()) {
+                reapplyRules_.erase(property);
+            }
+        }
+    }
+    const Condition* cond = rule->indexCondition();
+    if (!cond) {
+        eraseFrom(unindexedRules_);
+        return;
+    }
+    auto& values = ruleIndex_[cond->name];
+    auto& rules = values[cond->value_str];
+    eraseFrom(rules);
+    // drop empty entries, such that we do not query the property
+    // of new clients unnecessarily
+    if (rules.empty()) {
+        values.erase(cond->value_str);
+    }
+    if (values.empty()) {
+        ruleIndex_.erase(cond->name);
+    }
+}
+
 std::tuple<string, char, string> RuleManager::tokenizeArg(string arg) {
     if (arg.substr(0, 2) == "--") {
         arg.erase(0, 2);
@@ -199,7 +316,7 @@ void RuleManager::unruleCompletion(Completion& complete) {
 }
 
 void RuleManager::addRuleCompletion(Completion& complete) {
-    complete.full({ "not", "!", "prepend", "once", "printlabel" });
+    complete.full({ "not", "!", "prepend", "once", "printlabel", "reapply" });
     complete.partial("label=");
     for (auto&& matcher : Condition::matchers) {
         auto condName = matcher.first;
@@ -214,9 +331,60 @@ void RuleManager::addRuleCompletion(Completion& complete) {
 
 //! Evaluate rules against a given client
 ClientChanges RuleManager::evaluateRules(Client* client, ClientChanges changes) {
-    auto ruleIter = rules_.begin();
-    while (ruleIter != rules_.end()) {
-        auto& rule = *ruleIter;
+    // collect the rules that possibly match: the rules found in the index
+    // for the client's property values and all other rules
+    std::vector<Rule*> candidates = unindexedRules_;
+    for (const auto& index : ruleIndex_) {
+        auto value = Condition::stringProperties.at(index.first)(client);
+        if (!value.has_value()) {
+            continue;
+        }
+        auto it = index.second.find(value.value());
+        if (it != index.second.end()) {
+            candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+    }
+    return evaluateCandidates(candidates, client, changes);
+}
+
+ClientChanges RuleManager::reevaluateRules(const string& property, Client* client, ClientChanges changes) {
+    auto it = reapplyRules_.find(property);
+    if (it == reapplyRules_.end()) {
+        return changes;
+    }
+    return evaluateCandidates(it->second, client, changes);
+}
+
+//! evaluate the given rules in the order of the rule list
+ClientChanges RuleManager::evaluateCandidates(std::vector<Rule*> candidates, Client* client, ClientChanges changes) {
+    // apply them in the order of the rule list
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Rule* a, const Rule* b) {
+                  return a->position < b->position;
+              });
+
+    // the regex conditions on a property are all matched when the
+    // first of them is evaluated
+    std::map<string, std::set<string>> matchingRegexes;
+    auto conditionMatches = [&](const Condition& cond) {
+        if (!cond.isBulkRegex()) {
+            return Condition::matchers.at(cond.name)(&cond, client);
+        }
+        auto it = matchingRegexes.find(cond.name);
+        if (it == matchingRegexes.end()) {
+            std::set<string> matching;
+            auto value = Condition::stringProperties.at(cond.name)(client);
+            if (value.has_value()) {
+                matching = regexSets_.at(cond.name).matching(value.value());
+            }
+            it = matchingRegexes.insert({cond.name, matching}).first;
+        }
+        return it->second.count(cond.value_reg_exp.str()) > 0;
+    };
+
+    std::vector<Rule*> rulesToRemove;
+    for (Rule* rule : candidates) {
+        auto startTime = std::chrono::steady_clock::now();
         bool matches = true;    // if current condition matches
         bool rule_match = true; // if entire rule matches
         bool rule_expired = false;
@@ -229,7 +397,7 @@ ClientChanges RuleManager::evaluateRules(Client* client, ClientChanges changes)
                 continue;
             }
 
-            matches = Condition::matchers.at(cond.name)(&cond, client);
+            matches = conditionMatches(cond);
 
             if (!matches && !cond.negated
                 && cond.name == "maxage") {
@@ -243,6 +411,9 @@ ClientChanges RuleManager::evaluateRules(Client* client, ClientChanges changes)
             }
             rule_match = rule_match && matches;
         }
+        auto duration = std::chrono::steady_clock::now() - startTime;
+        rule->countEvaluation(rule_match, client,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
 
         if (rule_match) {
             // apply all consequences
@@ -260,12 +431,12 @@ ClientChanges RuleManager::evaluateRules(Client* client, ClientChanges changes)
 
         // remove it if not wanted or needed anymore
         if ((rule_match && rule->once) || rule_expired) {
-            ruleIter = rules_.erase(ruleIter);
-        } else {
-            // try next
-            ruleIter++;
+            rulesToRemove.push_back(rule);
         }
     }
+    for (Rule* rule : rulesToRemove) {
+        removeRule(rule);
+    }
 
     return changes;
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <list>
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "object.h"
 #include "rules.h"
@@ -12,11 +15,22 @@ public:
     void addRuleCompletion(Completion& complete);
     int unruleCommand(Input input, Output output);
     void unruleCompletion(Completion& complete);
-    int listRulesCommand(Output output);
+    int listRulesCommand(Input input, Output output);
+    void listRulesCompletion(Completion& complete);
     ClientChanges evaluateRules(Client* client, ClientChanges changes = {});
+    //! evaluate only the rules with the 'reapply' flag that depend on
+    //! the given property, e.g. after it changed
+    ClientChanges reevaluateRules(const std::string& property, Client* client, ClientChanges changes = {});
+    bool hasReapplyRules(const std::string& property) const {
+        return reapplyRules_.find(property) != reapplyRules_.end();
+    }
 
 private:
     size_t removeRules(std::string label);
+    void removeRule(Rule* rule);
+    void addToIndex(Rule* rule);
+    void removeFromIndex(Rule* rule);
+    ClientChanges evaluateCandidates(std::vector<Rule*> candidates, Client* client, ClientChanges changes);
     std::tuple<std::string, char, std::string> tokenizeArg(std::string arg);
 
     //! Ever-incrementing index for labeling new rules
@@ -24,4 +38,23 @@ private:
 
     //! Currently active rules
     std::list<std::unique_ptr<Rule>> rules_;
+
+    //! the Rule::position for the next rule that is prepended or appended
+    long long nextPositionFront_ = -1;
+    long long nextPositionBack_ = 0;
+
+    /*! The rules with an indexable condition (see Rule::indexCondition()).
+     * For each property name (e.g. "class"), this maps the value of the
+     * condition to the rules having this condition. This way, the rules for
+     * which the condition does not hold are not looked at at all.
+     */
+    std::map<std::string, std::unordered_map<std::string, std::vector<Rule*>>> ruleIndex_;
+    //! the rules that need to be checked for every client
+    std::vector<Rule*> unindexedRules_;
+    /*! For each property, the regexes of all regex conditions on it (see
+     * Condition::isBulkRegex()), which are matched at once per client.
+     */
+    std::map<std::string, RegexSet> regexSets_;
+    //! for each property, the rules with the 'reapply' flag depending on it
+    std::map<std::string, std::vector<Rule*>> reapplyRules_;
 };
@@ -4,12 +4,9 @@
 #include <cstdio>
 
 #include "client.h"
-#include "ewmh.h"
 #include "finite.h"
 #include "hook.h"
-#include "root.h"
 #include "utils.h"
-#include "xconnection.h"
 
 using std::string;
 
@@ -26,6 +23,14 @@ const std::map<string, Condition::Matcher> Condition::matchers = {
     { "windowrole",     &Condition::matchesWindowrole        },
 };
 
+const std::map<string, Condition::PropertyGetter> Condition::stringProperties = {
+    { "class",      [](const Client* c) { return c->wmClass(); } },
+    { "instance",   [](const Client* c) { return c->wmInstance(); } },
+    { "title",      [](const Client* c) { return c->title_(); } },
+    { "windowtype", [](const Client* c) { return c->windowType(); } },
+    { "windowrole", [](const Client* c) { return c->windowRole(); } },
+};
+
 const std::map<string, Consequence::Applier> Consequence::appliers = {
     { "tag",            &Consequence::applyTag             },
     { "index",          &Consequence::applyIndex           },
@@ -72,14 +77,13 @@ bool Rule::addCondition(string name, char op, const char* value, bool negated, O
         case '~': {
             cond.value_type = CONDITION_VALUE_TYPE_REGEX;
             try {
-                cond.value_reg_exp = std::regex(value, std::regex::extended);
-            } catch(std::regex_error& err) {
+                cond.value_reg_exp = RegexStr::fromStr(value);
+            } catch(std::invalid_argument& err) {
                 output << "rule: Cannot parse value \"" << value
                         << "\" from condition \"" << name
                         << "\": \"" << err.what() << "\"\n";
                 return false;
             }
-            cond.value_reg_str = value;
             break;
         }
 
@@ -137,12 +141,67 @@ bool Rule::setLabel(char op, string value, Output output) {
 
 // rules parsing //
 
-Rule::Rule() {
+Rule::Rule()
+    : labelAttr_(this, "label", &Rule::getLabel)
+    , evaluationsAttr_(this, "evaluations", &Rule::getEvaluations)
+    , matchesAttr_(this, "matches", &Rule::getMatches)
+    , evaluationTimeAttr_(this, "time", &Rule::getEvaluationTime)
+    , lastMatchAttr_(this, "last_match", &Rule::getLastMatch)
+{
     birth_time = get_monotonic_timestamp();
 }
 
+/*!
+ * The rule can only match if its first indexable condition matches, so it is
+ * enough to look at the rule if the client's property has that value.
+ * Rules with a maxage condition are never indexed, because they expire
+ * while being checked against any client.
+ */
+const Condition* Rule::indexCondition() const {
+    const Condition* result = nullptr;
+    for (const auto& cond : conditions) {
+        if (cond.name == "maxage") {
+            return nullptr;
+        }
+        if (!result && cond.isIndexable()) {
+            result = &cond;
+        }
+    }
+    return result;
+}
+
+std::set<string> Rule::dependencies() const {
+    std::set<string> result;
+    for (const auto& cond : conditions) {
+        if (Condition::stringProperties.count(cond.name)) {
+            result.insert(cond.name);
+        }
+    }
+    return result;
+}
+
+void Rule::countEvaluation(bool matched, const Client* client, unsigned long nanoseconds) {
+    evaluations_++;
+    evaluationTime_ += nanoseconds;
+    if (matched) {
+        matches_++;
+        lastMatch_ = client->window_id_str();
+    }
+}
+
+//! print the counters and then the rule itself
+void Rule::printStats(Output output) {
+    output << "time=" << evaluationTime_ << "\t"
+           << "evaluations=" << evaluations_ << "\t"
+           << "matches=" << matches_ << "\t";
+    print(output);
+}
+
 void Rule::print(Output output) {
     output << "label=" << label << "\t";
+    if (reapply) {
+        output << "reapply\t";
+    }
 
     // Append conditions
     for (auto const& cond : conditions) {
@@ -155,7 +214,7 @@ void Rule::print(Output output) {
                 output << "=" << cond.value_str << "\t";
                 break;
             case CONDITION_VALUE_TYPE_REGEX:
-                output << "~" << cond.value_reg_str << "\t";
+                output << "~" << cond.value_reg_exp.str() << "\t";
                 break;
             default: /* CONDITION_VALUE_TYPE_INTEGER: */
                 output << "=" << cond.value_integer << "\t";
@@ -183,7 +242,12 @@ bool Condition::matches(const string& str) const {
             return value_str == str;
             break;
         case CONDITION_VALUE_TYPE_REGEX:
-            return std::regex_match(str, value_reg_exp);
+            if (value_reg_exp.empty()) {
+                // RegexStr treats "" as unset, but the empty
+                // pattern in a condition only matches the empty string
+                return str.empty();
+            }
+            return value_reg_exp.matches(str);
             break;
         case CONDITION_VALUE_TYPE_INTEGER:
             try {
@@ -196,12 +260,23 @@ bool Condition::matches(const string& str) const {
     return false;
 }
 
+bool Condition::isIndexable() const {
+    return !negated
+        && value_type == CONDITION_VALUE_TYPE_STRING
+        && stringProperties.find(name) != stringProperties.end();
+}
+
+bool Condition::isBulkRegex() const {
+    return value_type == CONDITION_VALUE_TYPE_REGEX
+        && stringProperties.find(name) != stringProperties.end();
+}
+
 bool Condition::matchesClass(const Client* client) const {
-    return matches(Root::get()->X.getClass(client->window_));
+    return matches(client->wmClass());
 }
 
 bool Condition::matchesInstance(const Client* client) const {
-    return matches(Root::get()->X.getInstance(client->window_));
+    return matches(client->wmInstance());
 }
 
 bool Condition::matchesTitle(const Client* client) const {
@@ -240,18 +315,15 @@ bool Condition::matchesMaxage(const Client* client) const {
 }
 
 bool Condition::matchesWindowtype(const Client* client) const {
-    auto& ewmh = Ewmh::get();
-    int wintype = ewmh.getWindowType(client->x11Window());
-    if (wintype < 0) {
+    auto& wintype = client->windowType();
+    if (!wintype.has_value()) {
         return false;
     }
-    return matches(ewmh.netatomName(wintype));
+    return matches(wintype.value());
 }
 
 bool Condition::matchesWindowrole(const Client* client) const {
-    auto& X = Root::get()->X;
-    auto role = X.getWindowProperty(client->window_, X.atom("WM_WINDOW_ROLE"));
-
+    auto& role = client->windowRole();
     if (!role.has_value()) {
         return false;
     }
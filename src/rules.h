@@ -2,8 +2,10 @@
 #define __HS_RULES_H_
 
 #include <functional>
-#include <regex>
+#include <set>
 
+#include "attribute_.h"
+#include "object.h"
 #include "optional.h"
 #include "regexstr.h"
 #include "types.h"
@@ -26,14 +28,32 @@ public:
     using Matcher = std::function<bool(const Condition*, const Client*)>;
     static const std::map<std::string, Matcher> matchers;
 
+    /*! Returns the value of a string property of a client, or nothing if the
+     * client does not have the property at all.
+     */
+    using PropertyGetter = std::function<std::experimental::optional<std::string>(const Client*)>;
+    /*! The properties whose matcher compares a string against the
+     * condition, each mapped to the getter of this string. The
+     * RuleManager uses them to handle conditions on them in bulk:
+     * non-negated exact-match conditions are looked up in a hash table
+     * and all regex conditions on a property are matched at once (see
+     * RuleManager::evaluateRules()).
+     */
+    static const std::map<std::string, PropertyGetter> stringProperties;
+
+    //! whether this condition can only match if the property 'name'
+    //! equals value_str
+    bool isIndexable() const;
+    //! whether this is a regex condition on one of the stringProperties
+    bool isBulkRegex() const;
+
     std::string name;
     int value_type = 0;
     bool negated = false;
 
     std::string value_str;
     int value_integer = 0;
-    std::regex value_reg_exp;
-    std::string value_reg_str;
+    RegexStr value_reg_exp;
 
     /*! Timestamp of when this condition (i.e. rule) was created, which is
      * needed for the maxage matcher.
@@ -131,21 +151,58 @@ private:
     void applyFloatplacement(const Client* client, ClientChanges* changes) const;
 };
 
-class Rule {
+class Rule : public Object {
 public:
     Rule();
 
     std::string label;
+    //! the name of the rule in the object tree
+    std::string objectName;
     std::vector<Condition> conditions;
     std::vector<Consequence> consequences;
     bool once = false;
+    //! whether the rule is applied again when a property it depends on changes
+    bool reapply = false;
     time_t birth_time; // timestamp of at creation
+    //! position in the list of rules. It is used for keeping the order of
+    //! rules that are found via the index of exact-match conditions.
+    long long position = 0;
+
+    //! the condition the rule is indexed by, or nullptr if the rule needs
+    //! to be checked for every client
+    const Condition* indexCondition() const;
+    //! the client properties (see Condition::stringProperties) whose
+    //! changes can alter the outcome of the rule's conditions
+    std::set<std::string> dependencies() const;
 
     bool setLabel(char op, std::string value, Output output);
     bool addCondition(std::string name, char op, const char* value, bool negated, Output output);
     bool addConsequence(std::string name, char op, const char* value, Output output);
 
     void print(Output output);
+
+    //! account one evaluation of the rule that took the given time
+    void countEvaluation(bool matched, const Client* client, unsigned long nanoseconds);
+    unsigned long evaluationTime() const { return evaluationTime_; }
+    void printStats(Output output);
+
+private:
+    std::string getLabel() const { return label; }
+    unsigned long getEvaluations() const { return evaluations_; }
+    unsigned long getMatches() const { return matches_; }
+    unsigned long getEvaluationTime() const { return evaluationTime_; }
+    std::string getLastMatch() const { return lastMatch_; }
+
+    unsigned long evaluations_ = 0;
+    unsigned long matches_ = 0;
+    unsigned long evaluationTime_ = 0; // in nanoseconds
+    std::string lastMatch_;
+
+    DynAttribute_<std::string> labelAttr_;
+    DynAttribute_<unsigned long> evaluationsAttr_;
+    DynAttribute_<unsigned long> matchesAttr_;
+    DynAttribute_<unsigned long> evaluationTimeAttr_;
+    DynAttribute_<std::string> lastMatchAttr_;
 };
 
 #endif
@@ -22,8 +22,22 @@ const std::array<const char*, LAYER_COUNT>g_layer_names =
      { LAYER_FRAMES      , "Frame Layer"                },
 }).a;
 
+std::set<Stack*> Stack::s_scheduled;
+
+Stack::Stack()
+    : layers_ {
+        LAYER_FOCUS,
+        LAYER_FULLSCREEN,
+        LAYER_FLOATING,
+        LAYER_NORMAL,
+        LAYER_FRAMES,
+    }
+{
+    static_assert(LAYER_COUNT == 5, "every layer needs a SliceLayer");
+}
 
 Stack::~Stack() {
+    s_scheduled.erase(this);
     for (int i = 0; i < LAYER_COUNT; i++) {
         if (!layers_[i].empty()) {
             HSDebug("Warning: %s of stack %p was not empty on destroy\n",
@@ -33,7 +47,7 @@ Stack::~Stack() {
 }
 
 Slice::Slice() {
-    layers.insert(LAYER_NORMAL);
+    layers = 1u << LAYER_NORMAL;
 }
 
 Slice* Slice::makeWindowSlice(Window window) {
@@ -45,8 +59,7 @@ Slice* Slice::makeWindowSlice(Window window) {
 
 Slice* Slice::makeFrameSlice(Window window) {
     auto s = Slice::makeWindowSlice(window);
-    s->layers.clear();
-    s->layers.insert(LAYER_FRAMES);
+    s->layers = 1u << LAYER_FRAMES;
     return s;
 }
 
@@ -56,30 +69,97 @@ Slice* Slice::makeClientSlice(Client* client) {
     s->type = Type::ClientSlice;
     s->data.client = client;
     if (client->floating_()) {
-        s->layers.clear();
-        s->layers.insert(LAYER_FLOATING);
+        s->layers = 1u << LAYER_FLOATING;
     }
     return s;
 }
 
 HSLayer Slice::highestLayer() const {
-    if (layers.empty()) {
-        return LAYER_COUNT;
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        if (inLayer((HSLayer)i)) {
+            return (HSLayer)i;
+        }
+    }
+    return LAYER_COUNT;
+}
+
+void SliceLayer::insert(Slice* slice, bool insertOnTop) {
+    Slice::Link& link = slice->links_[layer_];
+    if (link.owner) {
+        // a slice can be contained in at most one stack per layer
+        link.owner->remove(slice);
+    }
+    link.owner = this;
+    if (insertOnTop) {
+        link.below = top_;
+        if (top_) {
+            top_->links_[layer_].above = slice;
+        } else {
+            bottom_ = slice;
+        }
+        top_ = slice;
     } else {
-        return *(layers.begin());
+        link.above = bottom_;
+        if (bottom_) {
+            bottom_->links_[layer_].below = slice;
+        } else {
+            top_ = slice;
+        }
+        bottom_ = slice;
+    }
+}
+
+//! remove the slice from the layer, if it is contained in it
+void SliceLayer::remove(Slice* slice) {
+    Slice::Link& link = slice->links_[layer_];
+    if (link.owner != this) {
+        return;
+    }
+    if (link.above) {
+        link.above->links_[layer_].below = link.below;
+    } else {
+        top_ = link.below;
+    }
+    if (link.below) {
+        link.below->links_[layer_].above = link.above;
+    } else {
+        bottom_ = link.above;
+    }
+    link = {};
+}
+
+void SliceLayer::raise(Slice* slice) {
+    if (slice->links_[layer_].owner == this && top_ != slice) {
+        remove(slice);
+        insert(slice);
+    }
+}
+
+void SliceLayer::clear() {
+    Slice* slice = top_;
+    while (slice) {
+        Slice* next = slice->links_[layer_].below;
+        slice->links_[layer_] = {};
+        slice = next;
     }
+    top_ = nullptr;
+    bottom_ = nullptr;
 }
 
 void Stack::insertSlice(Slice* elem) {
-    for (auto layer : elem->layers) {
-        layers_[layer].insert(elem);
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        if (elem->inLayer((HSLayer)i)) {
+            layers_[i].insert(elem);
+        }
     }
     dirty = true;
 }
 
 void Stack::removeSlice(Slice* elem) {
-    for (auto layer : elem->layers) {
-        layers_[layer].remove(elem);
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        if (elem->inLayer((HSLayer)i)) {
+            layers_[i].remove(elem);
+        }
     }
     dirty = true;
 }
@@ -141,19 +221,31 @@ void Stack::restack() {
     }
     vector<Window> buf;
     extractWindows(false, [&buf](Window w) { buf.push_back(w); });
-    XRestackWindows(g_display, buf.data(), buf.size());
+    // the windows of a tag form a contiguous block below the stacking window
+    // of its monitor, so it does not matter which of them keeps its position
+    WindowStacking::get().restack(buf, false);
     dirty = false;
+    s_scheduled.erase(this);
     Ewmh::get().updateClientListStacking();
 }
 
+//! restack all stacks whose slices were raised since the last call. This is
+//! called once per event loop iteration such that a sequence of raises only
+//! causes a single restack.
+void Stack::restackScheduled() {
+    while (!s_scheduled.empty()) {
+        (*s_scheduled.begin())->restack();
+    }
+}
+
 void Stack::raiseSlice(Slice* slice) {
-    for (auto layer : slice->layers) {
-        layers_[layer].raise(slice);
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        if (slice->inLayer((HSLayer)i)) {
+            layers_[i].raise(slice);
+        }
     }
     dirty = true;
-    // TODO: maybe only update the specific range and not the entire stack
-    // update
-    restack();
+    s_scheduled.insert(this);
 }
 
 void Stack::markDirty() {
@@ -163,12 +255,12 @@ void Stack::markDirty() {
 //! insert the slice to the given layer. if 'insertOnTop' is set, insert at the top
 //! otherwise insert at the bottom of the layer
 void Stack::sliceAddLayer(Slice* slice, HSLayer layer, bool insertOnTop) {
-    if (slice->layers.count(layer) != 0) {
+    if (slice->inLayer(layer)) {
         /* nothing to do */
         return;
     }
 
-    slice->layers.insert(layer);
+    slice->layers |= 1u << layer;
     layers_[layer].insert(slice, insertOnTop);
     dirty = true;
 }
@@ -178,11 +270,7 @@ void Stack::sliceRemoveLayer(Slice* slice, HSLayer layer) {
     layers_[layer].remove(slice);
     dirty = true;
 
-    if (slice->layers.count(layer) == 0) {
-        return;
-    }
-
-    slice->layers.erase(layer);
+    slice->layers &= ~(1u << layer);
 }
 
 bool Stack::isLayerEmpty(HSLayer layer) {
@@ -190,9 +278,163 @@ bool Stack::isLayerEmpty(HSLayer layer) {
 }
 
 void Stack::clearLayer(HSLayer layer) {
-    while (!isLayerEmpty(layer)) {
-        sliceRemoveLayer(*layers_[layer].begin(), layer);
-        dirty = true;
+    for (auto slice : layers_[layer]) {
+        slice->layers &= ~(1u << layer);
+    }
+    layers_[layer].clear();
+    dirty = true;
+}
+
+
+WindowStacking& WindowStacking::get() {
+    static WindowStacking stacking;
+    return stacking;
+}
+
+/** stack the given windows (from top to bottom) directly below each other.
+ * If keepFirst is set, then the first window stays where it is, like in
+ * XRestackWindows(). Otherwise, the windows may be stacked anywhere the
+ * existing order of some of them allows it. Only the windows whose
+ * neighbours change are moved, so raising a single window moves only a
+ * constant number of windows.
+ */
+void WindowStacking::restack(const vector<Window>& windows, bool keepFirst) {
+    if (windows.size() < 2) {
+        return;
+    }
+    // find the first pair of windows that is already stacked correctly
+    size_t anchor = windows.size();
+    for (size_t i = 0; i + 1 < windows.size(); i++) {
+        auto it = above_.find(windows[i + 1]);
+        if (it != above_.end() && it->second == windows[i]) {
+            anchor = i;
+            break;
+        }
+    }
+    if (anchor == windows.size()) {
+        // nothing is known about the order of these windows, e.g. after
+        // invalidate(), so a single request is cheaper than moving each
+        vector<Window> buf = windows;
+        XRestackWindows(g_display, buf.data(), static_cast<int>(buf.size()));
+        // forget the former neighbours without linking them to each other,
+        // because the first window stays between them
+        for (Window window : windows) {
+            auto upper = above_.find(window);
+            if (upper != above_.end()) {
+                below_.erase(upper->second);
+                above_.erase(upper);
+            }
+            auto lower = below_.find(window);
+            if (lower != below_.end()) {
+                above_.erase(lower->second);
+                below_.erase(lower);
+            }
+        }
+        for (size_t i = 1; i < windows.size(); i++) {
+            link(windows[i - 1], windows[i]);
+        }
+        return;
+    }
+    if (keepFirst) {
+        anchor = 0;
+    }
+    for (size_t i = anchor; i > 0; i--) {
+        Window window = windows[i - 1];
+        Window lower = windows[i];
+        auto it = below_.find(window);
+        if (it != below_.end() && it->second == lower) {
+            continue;
+        }
+        move(window, lower, Above);
+    }
+    for (size_t i = anchor + 1; i < windows.size(); i++) {
+        Window upper = windows[i - 1];
+        Window window = windows[i];
+        auto it = above_.find(window);
+        if (it != above_.end() && it->second == upper) {
+            continue;
+        }
+        move(window, upper, Below);
+    }
+}
+
+//! move the window directly above or below the given sibling
+void WindowStacking::move(Window window, Window sibling, int stackMode) {
+    XWindowChanges wc;
+    wc.sibling = sibling;
+    wc.stack_mode = stackMode;
+    XConfigureWindow(g_display, window, CWSibling | CWStackMode, &wc);
+    unlink(window);
+    if (stackMode == Above) {
+        auto oldUpper = above_.find(sibling);
+        if (oldUpper != above_.end()) {
+            Window upper = oldUpper->second;
+            above_.erase(oldUpper);
+            below_.erase(upper);
+            link(upper, window);
+        }
+        link(window, sibling);
+    } else {
+        auto oldLower = below_.find(sibling);
+        if (oldLower != below_.end()) {
+            Window lower = oldLower->second;
+            below_.erase(oldLower);
+            above_.erase(lower);
+            link(window, lower);
+        }
+        link(sibling, window);
+    }
+}
+
+void WindowStacking::raise(Window window) {
+    XRaiseWindow(g_display, window);
+    unlink(window);
+}
+
+void WindowStacking::forget(Window window) {
+    unlink(window);
+    foreignSiblings_.erase(window);
+}
+
+void WindowStacking::invalidate() {
+    above_.clear();
+    below_.clear();
+}
+
+bool WindowStacking::isKnown(Window window) const {
+    return above_.count(window) > 0 || below_.count(window) > 0;
+}
+
+/** Every ConfigureNotify of a window that is not ours lands here, also for
+ * mere moves and resizes. Only if it was put on top of a different sibling
+ * it might now be between two of our windows.
+ */
+void WindowStacking::foreignConfigured(Window window, Window sibling) {
+    auto it = foreignSiblings_.find(window);
+    bool restacked = it == foreignSiblings_.end() || it->second != sibling;
+    foreignSiblings_[window] = sibling;
+    if (restacked && sibling != None) {
+        invalidate();
     }
 }
 
+//! remove the window from the known stacking order, such that its former
+//! neighbours become neighbours of each other
+void WindowStacking::unlink(Window window) {
+    auto upper = above_.find(window);
+    auto lower = below_.find(window);
+    if (upper != above_.end() && lower != below_.end()) {
+        link(upper->second, lower->second);
+    } else if (upper != above_.end()) {
+        below_.erase(upper->second);
+    } else if (lower != below_.end()) {
+        above_.erase(lower->second);
+    }
+    above_.erase(window);
+    below_.erase(window);
+}
+
+void WindowStacking::link(Window upper, Window lower) {
+    below_[upper] = lower;
+    above_[lower] = upper;
+}
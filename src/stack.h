@@ -6,8 +6,8 @@
 #include <functional>
 #include <set>
 #include <string>
-
-#include "plainstack.h"
+#include <unordered_map>
+#include <vector>
 
 enum HSLayer {
     /* layers on each tag, from top to bottom */
@@ -22,6 +22,7 @@ enum HSLayer {
 extern const std::array<const char*, LAYER_COUNT> g_layer_names;
 
 class Client;
+class SliceLayer;
 
 class Slice {
 public:
@@ -41,10 +42,21 @@ public:
     void extractWindowsFromSlice(bool real_clients, HSLayer layer,
                                  std::function<void(Window)> yield);
 
-    std::set<HSLayer> layers; //!< layers this slice is contained in
+    bool inLayer(HSLayer layer) const { return (layers & (1u << layer)) != 0; }
+
+    unsigned int layers = 0; //!< bitmask of the layers this slice is contained in
 private:
+    friend class SliceLayer;
     HSLayer highestLayer() const;
 
+    //! the position of the slice in the SliceLayer of some layer
+    struct Link {
+        SliceLayer* owner = nullptr;
+        Slice* above = nullptr;
+        Slice* below = nullptr;
+    };
+    Link links_[LAYER_COUNT];
+
     Type type = {};
     union {
         Client*    client;
@@ -52,9 +64,48 @@ private:
     } data = {};
 };
 
+/** The slices of a single layer of a stack, from top to bottom. The slices
+ * are linked with each other, such that inserting, removing and raising a
+ * slice takes constant time.
+ */
+class SliceLayer {
+public:
+    SliceLayer(HSLayer layer) : layer_(layer) {}
+
+    class Iterator {
+    public:
+        Iterator(Slice* slice, HSLayer layer) : slice_(slice), layer_(layer) {}
+        Slice* operator*() const { return slice_; }
+        Iterator& operator++() {
+            slice_ = SliceLayer::below(slice_, layer_);
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return slice_ != other.slice_; }
+    private:
+        Slice* slice_;
+        HSLayer layer_;
+    };
+
+    void insert(Slice* slice, bool insertOnTop = true);
+    void remove(Slice* slice);
+    void raise(Slice* slice);
+    void clear();
+    bool empty() const { return top_ == nullptr; }
+    Iterator begin() const { return { top_, layer_ }; }
+    Iterator end() const { return { nullptr, layer_ }; }
+
+private:
+    static Slice* below(Slice* slice, HSLayer layer) {
+        return slice->links_[layer].below;
+    }
+    HSLayer layer_;
+    Slice* top_ = nullptr;
+    Slice* bottom_ = nullptr;
+};
+
 class Stack {
 public:
-    Stack() = default;
+    Stack();
     ~Stack();
 
     void insertSlice(Slice* elem);
@@ -68,12 +119,44 @@ public:
 
     void extractWindows(bool real_clients, std::function<void(Window)> yield);
     void restack();
+    static void restackScheduled();
 
-    PlainStack<Slice*> layers_[LAYER_COUNT];
+    SliceLayer layers_[LAYER_COUNT];
 
 private:
     //! Whether the stacking order has changed but wasn't restacked yet
     bool dirty = false;
+    //! stacks whose restack is deferred to the end of the event loop iteration
+    static std::set<Stack*> s_scheduled;
+};
+
+/** The parts of the X stacking order that were established by our own
+ * restacking requests: for each window, the window directly above it.
+ * This allows to restack a list of windows by only moving those windows
+ * whose upper neighbour changed, instead of reconfiguring all of them.
+ */
+class WindowStacking {
+public:
+    static WindowStacking& get();
+    void restack(const std::vector<Window>& windows, bool keepFirst = true);
+    //! raise the window on top of all its siblings
+    void raise(Window window);
+    //! the window was moved by someone else or destroyed
+    void forget(Window window);
+    //! the stacking order was modified in an unknown way
+    void invalidate();
+    //! whether the window is part of the known stacking order
+    bool isKnown(Window window) const;
+    //! a window we do not stack reported the given sibling below it
+    void foreignConfigured(Window window, Window sibling);
+private:
+    void move(Window window, Window sibling, int stackMode);
+    void unlink(Window window);
+    void link(Window upper, Window lower);
+    std::unordered_map<Window, Window> above_; //! the window directly above
+    std::unordered_map<Window, Window> below_; //! the window directly below
+    //! the last reported sibling of windows restacked by others
+    std::unordered_map<Window, Window> foreignSiblings_;
 };
 
 #endif
@@ -96,7 +96,7 @@ void HSTag::applyFloatingState(Client* client)
     }
     if (client->floating_()) {
         // client wants to be floated
-        if (!frame->root_->removeClient(client)) {
+        if (!frame->removeClient(client)) {
             return;
         }
         floating_clients_.push_back(client);
@@ -130,7 +130,7 @@ void HSTag::setVisible(bool visible)
 }
 
 bool HSTag::removeClient(Client* client) {
-    if (frame->root_->removeClient(client)) {
+    if (frame->removeClient(client)) {
         return true;
     }
     auto it = std::find(floating_clients_.begin(), floating_clients_.end(), client);
@@ -242,7 +242,7 @@ int HSTag::focusInDirCommand(Input input, Output output)
     } else {
         neighbour_found = frame->focusInDirection(direction, external_only);
         if (neighbour_found) {
-            needsRelayout_.emit();
+            focusChanged_.emit();
         }
     }
     if (!neighbour_found && settings_->focus_crosses_monitor_boundaries()) {
@@ -345,7 +345,7 @@ int HSTag::cycleAllCommand(Input input, Output output)
         newFocus->raise();
     }
     // finally, redraw the layout
-    needsRelayout_.emit();
+    focusChanged_.emit();
     return 0;
 }
 
@@ -433,13 +433,17 @@ int HSTag::computeFrameCount() {
 
 int HSTag::countUrgentClients()
 {
-    int count = 0;
-    foreachClient([&](Client* client) {
-        if (client->urgent_()) {
-            count++;
-        }
-    });
-    return count;
+    return static_cast<int>(urgentClients_.size());
+}
+
+//! update the set of urgent clients on this tag
+void HSTag::setClientUrgent(Client* client, bool urgent)
+{
+    if (urgent) {
+        urgentClients_.insert(client);
+    } else {
+        urgentClients_.erase(client);
+    }
 }
 
 int HSTag::computeClientCount() {
@@ -475,10 +479,11 @@ void tag_force_update_flags() {
     }
     // update flags
     for (auto c : Root::common().clients()) {
-        auto client = c.second;
-        TAG_SET_FLAG(client->tag(), TAG_FLAG_USED);
-        if (client->urgent_) {
-            TAG_SET_FLAG(client->tag(), TAG_FLAG_URGENT);
+        TAG_SET_FLAG(c.second->tag(), TAG_FLAG_USED);
+    }
+    for (auto t : *global_tags) {
+        if (t->hasUrgentClients()) {
+            TAG_SET_FLAG(t, TAG_FLAG_URGENT);
         }
     }
 }
@@ -2,6 +2,7 @@
 #define __HERBSTLUFT_TAG_H_
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "attribute_.h"
@@ -53,7 +54,11 @@ public:
     Client* focusedClient();
 
     void insertClient(Client* client, std::string frameIndex = {}, bool focus = true);
+    void setClientUrgent(Client* client, bool urgent);
+    bool hasUrgentClients() const { return !urgentClients_.empty(); }
     Signal needsRelayout_;
+    //! like needsRelayout_, but only the focus changed
+    Signal focusChanged_;
 
     //! add the client's slice to this tag's stack
     void insertClientSlice(Client* client);
@@ -82,6 +87,8 @@ private:
     //! get the number of urgent clients on this tag
     int countUrgentClients();
     Settings* settings_;
+    //! the urgent clients on this tag, maintained by the clients
+    std::unordered_set<Client*> urgentClients_;
 };
 
 // for tags
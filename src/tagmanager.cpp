@@ -42,8 +42,10 @@ HSTag* TagManager::find(const string& name) {
 }
 
 void TagManager::completeTag(Completion& complete) {
-    for (auto t : *this) {
-        complete.full(t->name);
+    // the by-name object has the tags sorted by their names
+    auto range = complete.candidates(by_name_.children());
+    for (auto it = range.first; it != range.second; it++) {
+        complete.full(it->first);
     }
 }
 
@@ -72,6 +74,7 @@ HSTag* TagManager::add_tag(const string& name) {
     addIndexed(tag);
     tag->name.changed().connect([this,tag]() { this->onTagRename(tag); });
     tag->needsRelayout_.connect([this,tag]() { this->needsRelayout_.emit(tag); });
+    tag->focusChanged_.connect([this,tag]() { this->focusChanged_.emit(tag); });
 
     Ewmh::get().updateDesktops();
     Ewmh::get().updateDesktopNames();
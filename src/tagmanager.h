@@ -42,6 +42,7 @@ public:
     void updateFocusObject(Monitor* focusedMonitor);
     std::string isValidTagName(std::string name);
     Signal_<HSTag*> needsRelayout_;
+    Signal_<HSTag*> focusChanged_;
 private:
     std::function<void(Completion&)> frameCompletion(FrameCompleter completer);
     void onTagRename(HSTag* tag);
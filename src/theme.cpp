@@ -13,7 +13,7 @@ Theme::Theme() {
     };
     for (int i = 0; i < (int)Type::Count; i++) {
         addStaticChild(&dec[i], type_names[i]);
-        dec[i].triple_changed_.connect([this](){ this->theme_changed_.emit(); });
+        dec[i].triple_changed_.connect([this](){ this->onTripleChanged(); });
     }
 
     // forward attribute changes: only to tiling and floating
@@ -23,6 +23,40 @@ Theme::Theme() {
     urgent.makeProxyFor({&t.urgent, &f.urgent});
 }
 
+//! emit theme_changed_ only once for all changes caused by one attribute write
+void Theme::onTripleChanged() {
+    if (!ProxyAddTargetInterface::propagating()) {
+        theme_changed_.emit();
+        return;
+    }
+    if (!themeChangeQueued_) {
+        themeChangeQueued_ = true;
+        ProxyAddTargetInterface::afterPropagation([this]() {
+            this->themeChangeQueued_ = false;
+            this->theme_changed_.emit();
+        });
+    }
+}
+
+int ProxyAddTargetInterface::s_propagationDepth = 0;
+vector<std::function<void()>> ProxyAddTargetInterface::s_afterPropagation;
+
+ProxyAddTargetInterface::PropagationGuard::~PropagationGuard() {
+    s_propagationDepth--;
+    if (s_propagationDepth > 0) {
+        return;
+    }
+    vector<std::function<void()>> callbacks;
+    std::swap(callbacks, s_afterPropagation);
+    for (auto& cb : callbacks) {
+        cb();
+    }
+}
+
+void ProxyAddTargetInterface::afterPropagation(std::function<void()> callback) {
+    s_afterPropagation.push_back(callback);
+}
+
 DecorationScheme::DecorationScheme()
     : reset(this, "reset", &DecorationScheme::resetGetterHelper,
                            &DecorationScheme::resetSetterHelper)
@@ -41,6 +75,7 @@ DecorationScheme::DecorationScheme()
         &background_color,
     })
 {
+    scheme_changed_.connect([this]() { this->revision_++; });
     for (auto i : proxyAttributes_) {
         addAttribute(i->toAttribute());
         i->toAttribute()->setWriteable();
@@ -67,6 +102,7 @@ DecTriple::DecTriple()
 //! reset all attributes to a default value
 string DecorationScheme::resetSetterHelper(string)
 {
+    ProxyAddTargetInterface::PropagationGuard guard;
     for (auto it : attributes()) {
         it.second->resetValue();
     }
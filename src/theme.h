@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -19,6 +20,23 @@ public:
      * attributes only once in the constructor of DecorationScheme
      */
     virtual Attribute* toAttribute() = 0;
+
+    /** While an instance of this exists, attribute changes are propagated.
+     * When the last instance is destroyed, the callbacks registered with
+     * afterPropagation() are called.
+     */
+    class PropagationGuard {
+    public:
+        PropagationGuard() { s_propagationDepth++; }
+        ~PropagationGuard();
+    };
+    //! whether attribute values are propagated at the moment
+    static bool propagating() { return s_propagationDepth > 0; }
+    //! call the given function once the current propagation is finished
+    static void afterPropagation(std::function<void()> callback);
+private:
+    static int s_propagationDepth;
+    static std::vector<std::function<void()>> s_afterPropagation;
 };
 
 /** An attribute that is at the same time a proxy
@@ -33,17 +51,13 @@ public:
     }
 
     std::string change(const std::string &payload_str) override {
+        PropagationGuard guard;
         std::string msg = Attribute_<T>::change(payload_str);
         if (msg.empty()) {
-            // propagate the new attribute value
-            // ignoring their error message since we assume that
-            // they have the same type / validation as this attribute
-            for (auto target : targetObjects_) {
-                Attribute* a = target->attribute(this->name());
-                if (a != nullptr) {
-                    a->change(payload_str);
-                }
-            }
+            // propagate the new attribute value. The targets are
+            // AttributeProxy_<T> as well, so the value does not need
+            // to be parsed again
+            propagate();
         }
         return msg;
     }
@@ -51,6 +65,7 @@ public:
         targetObjects_.push_back(object);
     }
     bool resetValue() override {
+        PropagationGuard guard;
         bool res = Attribute_<T>::resetValue();
         if (res) {
             for (auto target : targetObjects_) {
@@ -66,6 +81,21 @@ public:
         return this;
     }
 private:
+    void propagate() {
+        for (auto target : targetObjects_) {
+            auto a = dynamic_cast<AttributeProxy_<T>*>(target->attribute(this->name()));
+            if (a != nullptr) {
+                a->setAndPropagate(this->payload_);
+            }
+        }
+    }
+    void setAndPropagate(const T& value) {
+        if (value != this->payload_) {
+            Attribute_<T>::operator=(value);
+            this->changedByUser_.emit(this->payload_);
+        }
+        propagate();
+    }
     std::vector<Object*> targetObjects_;
 };
 
@@ -89,6 +119,8 @@ public:
     AttributeProxy_<Color>   background_color = {"background_color", {"black"}}; // color behind client contents
 
     Signal scheme_changed_; //! whenever one of the attributes changes.
+    //! incremented whenever one of the attributes changes
+    unsigned long revision() const { return revision_; }
 
     Rectangle inner_rect_to_outline(Rectangle rect) const;
     Rectangle outline_to_inner_rect(Rectangle rect) const;
@@ -101,6 +133,7 @@ private:
     std::string resetSetterHelper(std::string dummy);
     std::string resetGetterHelper();
     std::vector<ProxyAddTargetInterface*> proxyAttributes_;
+    unsigned long revision_ = 0;
 };
 
 class DecTriple : public DecorationScheme {
@@ -142,6 +175,9 @@ public:
 
     // a sub-decoration for each type
     DecTriple dec[(int)Type::Count];
+private:
+    void onTripleChanged();
+    bool themeChangeQueued_ = false;
 };
 
 
@@ -15,7 +15,35 @@ void TilingResult::add(FrameDecoration* dec, const FrameDecorationData& frame_da
     frames.push_back(make_pair(dec,frame_data));
 }
 
-void TilingResult::mergeFrom(TilingResult& other) {
-    data.splice(data.end(), other.data);
-    frames.splice(frames.end(), other.frames);
+void TilingResult::mergeFrom(const TilingResult& other) {
+    data.insert(data.end(), other.data.begin(), other.data.end());
+    frames.insert(frames.end(), other.frames.begin(), other.frames.end());
+    focus = other.focus;
+    focused_frame = other.focused_frame;
+}
+
+void TilingResult::clear() {
+    data.clear();
+    frames.clear();
+    focus = {};
+    focused_frame = {};
+}
+
+static bool operator==(const TilingStep& a, const TilingStep& b) {
+    return a.geometry == b.geometry
+        && a.floated == b.floated
+        && a.needsRaise == b.needsRaise
+        && a.visible == b.visible
+        && a.minimalDecoration == b.minimalDecoration;
+}
+
+static bool operator==(const FrameDecorationData& a, const FrameDecorationData& b) {
+    return a.visible == b.visible
+        && a.hasClients == b.hasClients
+        && a.hasParent == b.hasParent
+        && a.geometry == b.geometry;
+}
+
+bool TilingResult::sameLayout(const TilingResult& other) const {
+    return data == other.data && frames == other.frames;
 }
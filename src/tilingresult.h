@@ -1,7 +1,7 @@
 #ifndef __HLWM_TILINGSTEP_H_
 #define __HLWM_TILINGSTEP_H_
 
-#include <list>
+#include <vector>
 
 #include "framedecoration.h"
 #include "x11-types.h"
@@ -22,7 +22,9 @@ public:
                                     //! smart_window_surroundings is active
 };
 
-// a tiling result contains the movement commands etc. for all clients
+// a tiling result contains the movement commands etc. for all clients.
+// The entries are stored in flat vectors, such that a TilingResult that is
+// cleared and filled again does not need to allocate anything.
 class TilingResult {
 public:
     TilingResult() = default;
@@ -32,11 +34,17 @@ public:
     Client* focus = {}; // the focused client
     FrameDecoration* focused_frame = {};
 
-    // merge all the tiling steps from other into this
-    void mergeFrom(TilingResult& other);
-
-    std::list<std::pair<FrameDecoration*,FrameDecorationData>> frames;
-    std::list<std::pair<Client*,TilingStep>> data;
+    // append all the tiling steps from other to this, and take
+    // over its focus
+    void mergeFrom(const TilingResult& other);
+    // remove all entries, but keep the allocated memory
+    void clear();
+    // whether both results have the same entries, possibly
+    // with a different focus
+    bool sameLayout(const TilingResult& other) const;
+
+    std::vector<std::pair<FrameDecoration*,FrameDecorationData>> frames;
+    std::vector<std::pair<Client*,TilingStep>> data;
 };
 
 
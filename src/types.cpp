@@ -12,25 +12,41 @@ Input &Input::operator>>(string &val)
 
 Input Input::fromHere()
 {
-    string cmd;
     if (empty()) {
         return {{}, {}};
     }
+    return slice(begin(), end());
+}
 
-    return Input(*(begin()), Container(begin() + 1, end()));
+Input Input::slice(Container::const_iterator from, Container::const_iterator to)
+{
+    if (from == to) {
+        return {{}, {}};
+    }
+    return Input(*from, container_, from + 1, to);
 }
 
 void Input::replace(const string &from, const string &to)
 {
-    for (auto &v : *container_) {
-        if (v == from) {
-            v = to;
-        }
-
-        if (*command_ == from) {
-            *command_ = to;
+    if (container_.use_count() > 1) {
+        // the arguments are shared with other Input objects, so
+        // take a private copy before modifying them
+        auto offset = begin_ - first_;
+        container_ = std::make_shared<Container>(first_, end_);
+        first_ = container_->cbegin();
+        end_ = container_->cend();
+        begin_ = first_ + offset;
+    }
+    auto first = container_->begin() + (first_ - container_->cbegin());
+    auto last = container_->begin() + (end_ - container_->cbegin());
+    for (auto it = first; it != last; it++) {
+        if (*it == from) {
+            *it = to;
         }
     }
+    if (*command_ == from) {
+        *command_ = to;
+    }
 }
 
 template<> void Converter<bool>::complete(Completion& complete, bool const* relativeTo)
@@ -41,11 +41,20 @@ public:
     //! construct a new Input where the first (current) arg is the command
     Input fromHere();
 
+    //! construct a new Input from the range [from, to) of the arguments,
+    //! where *from is the command. The arguments are shared, not copied.
+    Input slice(Container::const_iterator from, Container::const_iterator to);
+
     //! Replace every occurence of 'from' by 'to'
     //! @note this includes the command itself
     void replace(const std::string &from, const std::string &to);
 
 protected:
+    Input(const std::string command, std::shared_ptr<Container> container,
+          Container::const_iterator from, Container::const_iterator to)
+        : ArgList(container, from, to)
+        , command_(std::make_shared<std::string>(command)) {}
+
     //! Command name
     //! A shared pointer to avoid copies when passing Input around
     //! @note The C-style compatibility layer DEPENDS on the shared_ptr!
@@ -9,6 +9,7 @@
 
 #include "globals.h"
 #include "settings.h"
+#include "x11-utils.h"
 
 #if defined(__MACH__) && ! defined(CLOCK_REALTIME)
 #include <mach/clock.h>
@@ -134,27 +135,18 @@ string utf8_string_at(const string& str, size_t offset) {
 
 /**
  * \brief   emulates a double window border through the border pixmap mechanism
+ * for a window of the given size and border width (and the default depth)
  */
-void set_window_double_border(Display *dpy, Window win, int ibw,
+void set_window_double_border(Display *dpy, Window win,
+                              int width, int height, int bw, int ibw,
                               unsigned long inner_color,
                               unsigned long outer_color)
 {
-    XWindowAttributes wa;
-
-    if (!XGetWindowAttributes(dpy, win, &wa)) {
-        return;
-    }
-
-    int bw = wa.border_width;
-
     if (bw < 2 || ibw >= bw || ibw < 1) {
         return;
     }
 
-    int width = wa.width;
-    int height = wa.height;
-
-    auto depth = (unsigned)wa.depth;
+    auto depth = (unsigned)DefaultDepth(dpy, DefaultScreen(dpy));
 
     int full_width = width + 2 * bw;
     int full_height = height + 2 * bw;
@@ -188,7 +180,7 @@ void set_window_double_border(Display *dpy, Window win, int ibw,
     };
 
     Pixmap pix = XCreatePixmap(dpy, win, full_width, full_height, depth);
-    GC gc = XCreateGC(dpy, pix, 0, nullptr);
+    GC gc = shared_gc(pix, depth);
 
     /* outer border */
     XSetForeground(dpy, gc, outer_color);
@@ -199,7 +191,7 @@ void set_window_double_border(Display *dpy, Window win, int ibw,
     XFillRectangles(dpy, pix, gc, &rectangles.front(), rectangles.size());
 
     XSetWindowBorderPixmap(dpy, win, pix);
-    XFreeGC(dpy, gc);
+    // the X server keeps the pixmap as long as it is the window's border
     XFreePixmap(dpy, pix);
 }
 
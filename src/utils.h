@@ -63,7 +63,8 @@ template<class T, int S> struct ArrayInitializer {
 };
 
 // utils for tables
-void set_window_double_border(Display *dpy, Window win, int ibw,
+void set_window_double_border(Display *dpy, Window win,
+                              int width, int height, int bw, int ibw,
                               unsigned long inner_color, unsigned long outer_color);
 
 // returns the unichar in GSTR at position GSTR
@@ -3,6 +3,7 @@
 #include <X11/Xlib.h>
 #include <X11/extensions/shape.h>
 #include <X11/extensions/shapeconst.h>
+#include <map>
 
 #include "globals.h"
 
@@ -14,7 +15,6 @@ void window_cut_rect_hole(Window win, int width, int height, int framewidth) {
     // inspired by the xhole.c example
     // http://www.answers.com/topic/xhole-c
     Display* d = g_display;
-    GC gp;
     int bw = 100; // add a large border, just to be sure the border is visible
     int holewidth = width - 2*framewidth;
     int holeheight = height - 2*framewidth;
@@ -23,7 +23,7 @@ void window_cut_rect_hole(Window win, int width, int height, int framewidth) {
 
     /* create the pixmap that specifies the shape */
     Pixmap p = XCreatePixmap(d, win, width, height, 1);
-    gp = XCreateGC(d, p, 0, nullptr);
+    GC gp = shared_gc(p, 1);
     XSetForeground(d, gp, WhitePixel(d, g_screen));
     XFillRectangle(d, p, gp, 0, 0, width, height);
     XSetForeground(d, gp, BlackPixel(d, g_screen));
@@ -38,32 +38,26 @@ void window_cut_rect_hole(Window win, int width, int height, int framewidth) {
     the pixmap is slightly larger than the window to allow for the window
     border and title bar (as added by the window manager) to be visible */
     XShapeCombineMask(d, win, ShapeBounding, -bw, -bw, p, ShapeSet);
-    XFreeGC(d, gp);
     XFreePixmap(d, p);
 }
 
-void window_make_intransparent(Window win, int width, int height) {
-    // inspired by the xhole.c example
-    // http://www.answers.com/topic/xhole-c
-    Display* d = g_display;
-    GC gp;
-    int bw = 100; // add a large border, just to be sure the border is visible
-    width += 2*bw;
-    height += 2*bw;
-
-    /* create the pixmap that specifies the shape */
-    Pixmap p = XCreatePixmap(d, win, width, height, 1);
-    gp = XCreateGC(d, p, 0, nullptr);
-    XSetForeground(d, gp, WhitePixel(d, g_screen));
-    XFillRectangle(d, p, gp, 0, 0, width, height);
-    /* set the pixmap as the new window mask;
-    the pixmap is slightly larger than the window to allow for the window
-    border and title bar (as added by the window manager) to be visible */
-    XShapeCombineMask(d, win, ShapeBounding, -bw, -bw, p, ShapeSet);
-    XFreeGC(d, gp);
-    XFreePixmap(d, p);
+void window_make_intransparent(Window win) {
+    // removing the mask is cheaper than setting a mask that covers
+    // the entire window
+    XShapeCombineMask(g_display, win, ShapeBounding, 0, 0, None, ShapeSet);
 }
 
+GC shared_gc(Drawable drawable, unsigned int depth) {
+    // a GC can be used for all drawables of the same depth and screen
+    static std::map<unsigned int, GC> gcs;
+    auto it = gcs.find(depth);
+    if (it != gcs.end()) {
+        return it->second;
+    }
+    GC gc = XCreateGC(g_display, drawable, 0, nullptr);
+    gcs[depth] = gc;
+    return gc;
+}
 
 Point2D get_cursor_position() {
     Point2D point{};
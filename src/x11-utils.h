@@ -2,6 +2,7 @@
 #define __HERBST_X11_UTILS_H_
 
 #include <X11/X.h>
+#include <X11/Xlib.h>
 
 #include "x11-types.h"
 
@@ -9,7 +10,11 @@
 // of width framewidth remains
 void window_cut_rect_hole(Window win, int width, int height, int framewidth);
 // fill the hole again, i.e. remove all masks
-void window_make_intransparent(Window win, int width, int height);
+void window_make_intransparent(Window win);
+
+// a GC for drawables of the given depth that is kept for the entire runtime.
+// Its state must be set before each use.
+GC shared_gc(Drawable drawable, unsigned int depth);
 
 Point2D get_cursor_position();
 
@@ -24,13 +24,17 @@
 #include "root.h"
 #include "rules.h"
 #include "settings.h"
+#include "stack.h"
 #include "tag.h"
 #include "tagmanager.h"
 #include "utils.h"
 #include "xconnection.h"
 
 using std::function;
+using std::pair;
 using std::shared_ptr;
+using std::string;
+using std::vector;
 
 /** A custom event handler casting function.
  *
@@ -154,6 +158,9 @@ void XMainLoop::run() {
     int x11_fd;
     fd_set in_fds;
     x11_fd = ConnectionNumber(X_.display());
+    // apply what was collected during the startup
+    applyDeferredUpdates();
+    XFlush(X_.display());
     while (!aboutToQuit_) {
         FD_ZERO(&in_fds);
         FD_SET(x11_fd, &in_fds);
@@ -169,11 +176,27 @@ void XMainLoop::run() {
             if (handler != nullptr) {
                 (this ->* handler)(&event);
             }
+            applyDeferredUpdates();
             XSync(X_.display(), False);
         }
     }
 }
 
+//! send the updates that are collected during an event loop iteration
+void XMainLoop::applyDeferredUpdates() {
+    Stack::restackScheduled();
+    root_->ewmh->flushRootProperties();
+}
+
+//! call a command from the ipc server. The deferred updates are applied
+//! before the reply is sent, such that the caller sees the effects of the
+//! command, e.g. in the EWMH properties.
+pair<int,string> XMainLoop::callCommand(const vector<string>& call) {
+    auto result = HlwmCommon::callCommand(call);
+    applyDeferredUpdates();
+    return result;
+}
+
 void XMainLoop::quit() {
     aboutToQuit_ = true;
 }
@@ -188,6 +211,8 @@ void XMainLoop::dropEnterNotifyEvents()
         return;
     }
     XEvent ev;
+    // apply pending restacks first, such that their enter events are dropped
+    Stack::restackScheduled();
     XSync(X_.display(), False);
     while (XCheckMaskEvent(X_.display(), EnterWindowMask, &ev)) {
     }
@@ -238,7 +263,7 @@ void XMainLoop::createnotify(XCreateWindowEvent* event) {
     if (root_->ipcServer_.isConnectable(event->window)) {
         root_->ipcServer_.addConnection(event->window);
         root_->ipcServer_.handleConnection(event->window,
-                                           HlwmCommon::callCommand);
+            [this](const vector<string>& call) { return callCommand(call); });
     }
 }
 
@@ -323,6 +348,12 @@ void XMainLoop::configurerequest(XConfigureRequestEvent* cre) {
         wc.sibling = cre->above;
         wc.stack_mode = cre->detail;
         XConfigureWindow(X_.display(), cre->window, cre->value_mask, &wc);
+        if (cre->value_mask & CWSibling) {
+            // the window might end up between two of our windows
+            WindowStacking::get().invalidate();
+        } else if (cre->value_mask & CWStackMode) {
+            WindowStacking::get().forget(cre->window);
+        }
     }
 }
 
@@ -338,6 +369,15 @@ void XMainLoop::configurenotify(XConfigureEvent* event) {
             std::ostringstream void_output;
             root_->monitors->detectMonitorsCommand(input, void_output);
         }
+    } else if (event->event == g_root
+               && !WindowStacking::get().isKnown(event->window)
+               && !root_->clients()->client(event->window)
+               && !Decoration::toClient(event->window)
+               && !FrameDecoration::withWindow(event->window))
+    {
+        // a window we do not stack, e.g. an override-redirect window,
+        // was configured and might have been restacked
+        WindowStacking::get().foreignConfigured(event->window, event->above);
     }
     // HSDebug("name is: ConfigureNotify\n");
 }
@@ -345,6 +385,7 @@ void XMainLoop::configurenotify(XConfigureEvent* event) {
 void XMainLoop::destroynotify(XUnmapEvent* event) {
     // try to unmanage it
     //HSDebug("name is: DestroyNotify for %lx\n", event->xdestroywindow.window);
+    WindowStacking::get().forget(event->window);
     auto cm = root_->clients();
     auto client = cm->client(event->window);
     if (client) {
@@ -375,7 +416,7 @@ void XMainLoop::enternotify(XCrossingEvent* ce) {
         }
         shared_ptr<FrameLeaf> target;
         if (c && c->tag()->floating == false
-              && (target = c->tag()->frame->root_->frameWithClient(c))
+              && (target = c->tag()->frame->findFrameWithClient(c))
               && target->getLayout() == LayoutAlgorithm::max
               && target->focusedClient() != c) {
             // don't allow focus_follows_mouse if another window would be
@@ -492,10 +533,14 @@ void XMainLoop::maprequest(XMapRequestEvent* mapreq) {
 void XMainLoop::propertynotify(XPropertyEvent* ev) {
     // printf("name is: PropertyNotify\n");
     Client* client = root_->clients->client(ev->window);
+    if (client != nullptr) {
+        // the property might be cached, also if it was deleted
+        client->invalidatePropertyCache();
+    }
     if (ev->state == PropertyNewValue) {
         if (root_->ipcServer_.isConnectable(ev->window)) {
             root_->ipcServer_.handleConnection(ev->window,
-                                               HlwmCommon::callCommand);
+                [this](const vector<string>& call) { return callCommand(call); });
         } else if (client != nullptr) {
             //char* atomname = XGetAtomName(X_.display(), ev->atom);
             //HSDebug("Property notify for client %s: atom %d \"%s\"\n",
@@ -513,6 +558,11 @@ void XMainLoop::propertynotify(XPropertyEvent* ev) {
             } else if (ev->atom == XA_WM_NAME ||
                        ev->atom == root_->ewmh->netatom(NetWmName)) {
                 client->update_title();
+                root_->clients()->propertyChanged(client, "title");
+            } else if (ev->atom == root_->ewmh->netatom(NetWmWindowType)) {
+                root_->clients()->propertyChanged(client, "windowtype");
+            } else if (ev->atom == root_->ewmh->wmatom(Ewmh::WM::WindowRole)) {
+                root_->clients()->propertyChanged(client, "windowrole");
             } else if (ev->atom == XA_WM_CLASS && client) {
                 // according to the ICCCM specification, the WM_CLASS property may only
                 // be changed in the withdrawn state:
@@ -2,6 +2,9 @@
 
 #include <X11/X.h>
 #include <X11/Xlib.h>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "x11-types.h"
 
@@ -24,6 +27,8 @@ private:
     Root* root_;
     bool aboutToQuit_;
     EventHandler handlerTable_[LASTEvent];
+    void applyDeferredUpdates();
+    std::pair<int,std::string> callCommand(const std::vector<std::string>& call);
     // event handlers
     void buttonpress(XButtonEvent* be);
     void buttonrelease(XButtonEvent* event);
@@ -755,9 +755,10 @@ def x11(x11_connection):
             return geom
 
         def get_hlwm_frames(self):
-            """get list of window handles of herbstluftwm
+            """get list of window handles of the visible herbstluftwm
             frame decoration windows"""
-            cmd = ['xdotool', 'search', '--class', '_HERBST_FRAME']
+            # unmapped frame windows might be unused windows in the pool
+            cmd = ['xdotool', 'search', '--onlyvisible', '--class', '_HERBST_FRAME']
             frame_wins = subprocess.run(cmd,
                                         stdout=subprocess.PIPE,
                                         universal_newlines=True,
@@ -146,6 +146,18 @@ def test_client_wm_class_none(hlwm, x11):
     assert hlwm.get_attr('clients.{}.class'.format(winid)) == ''
 
 
+def test_client_wm_class_changes(hlwm, x11):
+    win, winid = x11.create_client(wm_class=('myinst', 'myclass'))
+    assert hlwm.get_attr('clients.{}.class'.format(winid)) == 'myclass'
+
+    win.set_wm_class('newinst', 'newclass')
+    x11.display.sync()
+    x11.sync_with_hlwm()
+
+    assert hlwm.get_attr('clients.{}.instance'.format(winid)) == 'newinst'
+    assert hlwm.get_attr('clients.{}.class'.format(winid)) == 'newclass'
+
+
 def test_bring_from_different_tag(hlwm, x11):
     _, bonnie = x11.create_client()
     hlwm.call('true')
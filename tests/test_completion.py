@@ -11,7 +11,6 @@ commands_without_input = shlex.split(
     list_commands
     list_keybinds
     list_monitors
-    list_rules
     lock
     mouseunbind
     quit
@@ -233,6 +232,17 @@ def test_metacommand(hlwm, command_prefix):
         == sorted(['ARG'] + cmdlist)
 
 
+def test_complete_prefix(hlwm):
+    cmdlist = hlwm.call('list_commands').stdout.splitlines()
+    assert hlwm.complete('set_a', position=0) \
+        == sorted([c for c in cmdlist if c.startswith('set_a')])
+    for t in ['foo', 'foobar', 'bar', 'fo']:
+        hlwm.call(['add', t])
+    assert hlwm.complete('floating foo', position=1) == ['foo', 'foobar']
+    assert hlwm.complete('attr tags.by-name.fo', position=1, partial=True) \
+        == ['tags.by-name.fo.', 'tags.by-name.foo.', 'tags.by-name.foobar.']
+
+
 def test_posix_escape(hlwm):
     tags = [r'tag"with\special', 'a&b', '$dollar', '(paren)']
     for t in tags:
@@ -253,3 +253,20 @@ def test_ewmh_make_client_urgent_no_focus_stealing(hlwm, hc_idle, x11):
     assert demandsAttent in x11.ewmh.getWmState(winHandle, str=True)
     assert 'focus' not in hlwm.list_children('clients')
     assert 'default' == hlwm.get_attr('tags.focus.name')
+
+
+def test_ewmh_root_properties_written_once_per_command(hlwm, x11):
+    skipped_before = int(hlwm.get_attr('ewmh_skipped_writes'))
+
+    # every 'add' updates the number of desktops and their names
+    hlwm.call('chain , add a , add b , add c')
+
+    assert x11.get_property('_NET_NUMBER_OF_DESKTOPS')[0] == 4
+    assert int(hlwm.get_attr('ewmh_skipped_writes')) >= skipped_before + 4
+
+    skipped_before = int(hlwm.get_attr('ewmh_skipped_writes'))
+    # switching forth and back does not change _NET_CURRENT_DESKTOP
+    hlwm.call('chain , use a , use default')
+
+    assert x11.get_property('_NET_CURRENT_DESKTOP')[0] == 0
+    assert int(hlwm.get_attr('ewmh_skipped_writes')) > skipped_before
@@ -1,4 +1,5 @@
 import pytest
+from Xlib import X
 
 
 @pytest.mark.parametrize('clientFocused', [0, 1, 2, 3])
@@ -132,3 +133,27 @@ def test_resize_floating_client(hlwm, x11, direction):
     if direction == 'down':
         assert y_before + geom_after.height == mon_height
         assert geom_after.width == geom_before.width
+
+
+def test_configure_request_without_effect_is_answered(hlwm, x11):
+    client, winid = x11.create_client()
+    hlwm.call(f'set_attr clients.{winid}.floating true')
+    client.change_attributes(event_mask=X.StructureNotifyMask)
+    client.configure(x=100, y=80)
+    x11.sync_with_hlwm()
+
+    def synthetic_configure_notifies():
+        x11.display.sync()
+        events = []
+        while x11.display.pending_events() > 0:
+            ev = x11.display.next_event()
+            if ev.type == X.ConfigureNotify and ev.send_event:
+                events.append(ev)
+        return events
+
+    synthetic_configure_notifies()
+    # request the geometry the client already has
+    client.configure(x=100, y=80)
+    x11.sync_with_hlwm()
+
+    assert len(synthetic_configure_notifies()) >= 1
@@ -988,3 +988,41 @@ def test_frame_index_attribute(hlwm):
         # after each splitting operation, check that
         # the frame's index attribute is correct:
         verify_frame_tree('tags.focus.tiling.root', '')
+
+
+def test_layout_recomputed_on_pseudotile_and_setting_change(hlwm, x11):
+    hlwm.call('set_layout max')
+    hlwm.call('set hide_covered_windows on')
+    win1, winid1 = x11.create_client()
+    win2, winid2 = x11.create_client()
+    hlwm.call(['jumpto', winid2])
+    assert x11.get_absolute_geometry(win1).x < 0
+
+    # if the top client is pseudotiled, the client below is visible again
+    hlwm.call(['set_attr', f'clients.{winid2}.pseudotile', 'on'])
+    x11.sync_with_hlwm()
+    x_before = x11.get_absolute_geometry(win1).x
+    assert x_before >= 0
+
+    # the layout is also recomputed if a setting changes
+    hlwm.call('set window_gap 20')
+    x11.sync_with_hlwm()
+    assert x11.get_absolute_geometry(win1).x == x_before + 20
+
+
+@pytest.mark.parametrize('command', ['focus_nth 1', 'cycle_all 1', 'focus down'])
+def test_focus_change_only_updates_involved_clients(hlwm, command):
+    hlwm.call('set_layout vertical')
+    winids = hlwm.create_clients(3)
+    hlwm.call('focus_nth 0')
+    old_focus = hlwm.get_attr('clients.focus.winid')
+    skipped = {w: hlwm.get_attr(f'clients.{w}.decoration_skipped_updates') for w in winids}
+
+    hlwm.call(command)
+
+    new_focus = hlwm.get_attr('clients.focus.winid')
+    assert new_focus != old_focus
+    # the remaining client was not involved in the focus change at all
+    for w in winids:
+        if w not in [old_focus, new_focus]:
+            assert hlwm.get_attr(f'clients.{w}.decoration_skipped_updates') == skipped[w]
@@ -74,6 +74,36 @@ def test_set_attr_can_not_set_writable(hlwm):
         .returncode == 3
 
 
+def test_set_attrs(hlwm):
+    hlwm.call('set_attrs theme.border_width 3 settings.frame_gap 7')
+
+    assert hlwm.get_attr('theme.border_width') == '3'
+    assert hlwm.get_attr('settings.frame_gap') == '7'
+    assert hlwm.get_attr('settings.monitors_locked') == '0'
+
+
+def test_set_attrs_all_or_nothing(hlwm):
+    hlwm.call('set_attr settings.frame_gap 4')
+
+    hlwm.call_xfail('set_attrs settings.frame_gap 9 theme.border_width foo') \
+        .expect_stderr('"foo" is not a valid value for border_width')
+
+    assert hlwm.get_attr('settings.frame_gap') == '4'
+    assert hlwm.get_attr('settings.monitors_locked') == '0'
+
+
+def test_set_attrs_missing_value(hlwm):
+    hlwm.call_xfail('set_attrs settings.frame_gap 9 theme.border_width') \
+        .expect_stderr('not enough arguments')
+
+
+def test_set_attrs_completion(hlwm):
+    assert hlwm.complete('set_attrs settings.frame_gap 3 settings.swap_monitors_to_get_tag') \
+        == 'false off on toggle true'.split(' ')
+    assert hlwm.complete('set_attrs monitors.c', position=1, partial=True) \
+        == []
+
+
 def test_substitute_missing_attribute__command_treated_as_attribute(hlwm):
     call = hlwm.call_xfail('substitute X echo X')
 
@@ -139,6 +169,15 @@ def test_sprintf_double_percentage_escapes(hlwm):
     assert call.stdout == '%\n'
 
 
+def test_sprintf_stored_format(hlwm):
+    hlwm.call(['new_attr', 'string', 'my_fmt', '%s/%c'])
+    count = hlwm.get_attr('tags.count')
+
+    for _ in range(0, 3):
+        call = hlwm.call('substitute F my_fmt sprintf X F tags.count foo echo X')
+        assert call.stdout == count + '/foo\n'
+
+
 def test_sprintf_completion_1_placeholder(hlwm):
     assert hlwm.complete('sprintf T %s', partial=True) \
         == sorted(hlwm.complete('get_attr', partial=True))
@@ -356,6 +395,14 @@ def test_chain_nested(hlwm):
         == 'a\nb Y echo c\n'
 
 
+def test_chain_substitute_does_not_affect_other_commands(hlwm):
+    count = hlwm.get_attr('tags.count')
+
+    proc = hlwm.call('chain , substitute X tags.count echo X , echo X')
+
+    assert proc.stdout == count + '\nX\n'
+
+
 def test_chain_and_1(hlwm):
     proc = hlwm.unchecked_call('and , echo foo , false , echo bar')
     assert proc.returncode == 1
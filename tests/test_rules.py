@@ -215,7 +215,7 @@ def test_monitor_consequence(hlwm, monitor_spec):
 def test_invalid_regex_in_condition(hlwm):
     call = hlwm.call_xfail('rule class~[b-a]')
 
-    assert call.stderr == 'rule: Cannot parse value "[b-a]" from condition "class": "Invalid range in bracket expression."\n'
+    assert call.stderr == 'rule: Cannot parse value "[b-a]" from condition "class": "Invalid range end"\n'
 
 
 def test_printlabel_flag(hlwm):
@@ -298,6 +298,27 @@ def test_condition_instance(hlwm):
     assert hlwm.get_attr('clients', winid, 'tag') == 'tag2'
 
 
+@pytest.mark.parametrize('last_rule_indexed', [True, False])
+def test_rule_order_with_exact_match_conditions(hlwm, last_rule_indexed):
+    for tag in ['tag2', 'tag3', 'tag4']:
+        hlwm.call(['add', tag])
+
+    # rules with exact-match conditions on 'instance' are looked up via
+    # an index, the others are checked for every client. Still, the
+    # rules must be applied in the order of the rule list.
+    hlwm.call('rule instance=xterm tag=tag2')
+    hlwm.call('rule prepend instance=xterm tag=tag4')
+    hlwm.call('rule pid~[0-9]* tag=tag3')
+    if last_rule_indexed:
+        hlwm.call('rule instance=xterm not class=foo tag=tag2')
+        expected_tag = 'tag2'
+    else:
+        expected_tag = 'tag3'
+    winid, _ = hlwm.create_client()
+
+    assert hlwm.get_attr('clients', winid, 'tag') == expected_tag
+
+
 def test_condition_class(hlwm):
     hlwm.call('add tag2')
 
@@ -308,6 +329,71 @@ def test_condition_class(hlwm):
     assert hlwm.get_attr('clients', winid, 'tag') == 'tag2'
 
 
+@pytest.mark.parametrize('regex,matches', [
+    ('foo|bar', True),
+    ('fo|bar', False),
+    ('oo|bar', False),
+    ('^foo$', True),
+    ('(f|b)o+', True),
+    ('o+', False),
+])
+def test_condition_regex_matches_entire_value(hlwm, x11, regex, matches):
+    hlwm.call('add tag2')
+    hlwm.call(['rule', 'class~' + regex, 'tag=tag2'])
+    _, winid = x11.create_client(wm_class=('inst', 'foo'))
+
+    expected_tag = 'tag2' if matches else 'default'
+    assert hlwm.get_attr('clients', winid, 'tag') == expected_tag
+
+
+@pytest.mark.parametrize('title,matches', [
+    ('a)', True),
+    ('b', True),
+    ('a', False),
+    ('a)b', False),
+    ('xb)', False),
+])
+def test_condition_regex_with_unmatched_parenthesis(hlwm, title, matches):
+    hlwm.call('add tag2')
+    # an unmatched ')' is an ordinary character in extended regexes
+    hlwm.call(['rule', 'title~a)|b', 'tag=tag2'])
+    winid, _ = hlwm.create_client(title=title)
+
+    expected_tag = 'tag2' if matches else 'default'
+    assert hlwm.get_attr('clients', winid, 'tag') == expected_tag
+
+
+def test_regex_conditions_with_unmatched_parenthesis_on_same_property(hlwm):
+    hlwm.call('add tag2')
+    hlwm.call(['rule', 'title~a)|b', 'tag=tag2'])
+    hlwm.call(['rule', 'title~c', 'floating=on'])
+
+    for title, tag, floating in [('a)', 'tag2', 'false'),
+                                 ('a', 'default', 'false'),
+                                 ('c', 'default', 'true')]:
+        winid, _ = hlwm.create_client(title=title)
+        assert hlwm.get_attr('clients', winid, 'tag') == tag
+        assert hlwm.get_attr('clients', winid, 'floating') == floating
+
+
+def test_many_regex_conditions_on_same_property(hlwm):
+    hlwm.call('add tag2')
+    hlwm.call('rule title~never.* tag=tag2')
+    hlwm.call('rule title~my.*title floating=on')
+    hlwm.call('rule title~my.*title pseudotile=on')
+    hlwm.call('rule not title~.*title fullscreen=on')
+    hlwm.call('rule not title~my.* label=toberemoved fullscreen=on')
+    hlwm.call('unrule toberemoved')
+    hlwm.call('rule title~ tag=tag2')
+
+    winid, _ = hlwm.create_client(title='mytitle')
+
+    assert hlwm.get_attr('clients', winid, 'tag') == 'default'
+    assert hlwm.get_attr('clients', winid, 'floating') == 'true'
+    assert hlwm.get_attr('clients', winid, 'pseudotile') == 'true'
+    assert hlwm.get_attr('clients', winid, 'fullscreen') == 'false'
+
+
 def test_consequence_invalid_argument(hlwm):
     # TODO: make this command fail at some point:
     hlwm.call('rule focus=not-a-boolean')
@@ -442,6 +528,63 @@ def test_wm_class_too_late(hlwm, x11):
     assert hlwm.get_attr('clients.{}.tag'.format(winid)) == 'tag2'
 
 
+@pytest.mark.parametrize('reapply', [True, False])
+def test_reapply_on_title_change(hlwm, x11, reapply):
+    hlwm.call('add tag2')
+    flags = ['reapply'] if reapply else []
+    hlwm.call(['rule'] + flags + ['title=late title', 'tag=tag2'])
+    # a rule not depending on the title is not applied again
+    hlwm.call('rule reapply class~.* floating=on')
+    winref, winid = x11.create_client()
+    assert hlwm.get_attr('clients.{}.floating'.format(winid)) == 'true'
+    hlwm.call(['set_attr', 'clients.{}.floating'.format(winid), 'false'])
+
+    winref.set_wm_name('late title')
+    x11.display.sync()
+    x11.sync_with_hlwm()
+
+    expected_tag = 'tag2' if reapply else 'default'
+    assert hlwm.get_attr('clients.{}.tag'.format(winid)) == expected_tag
+    assert hlwm.get_attr('clients.{}.floating'.format(winid)) == 'false'
+
+
+def test_reapply_in_list_rules(hlwm):
+    hlwm.call('rule reapply label=foo title=bar tag=baz')
+
+    assert hlwm.call('list_rules').stdout == \
+        'label=foo\treapply\ttitle=bar\ttag=baz\t\n'
+
+
+def test_rule_stats(hlwm):
+    hlwm.call('rule label=never class=doesnotexist floating=on')
+    hlwm.call('rule label=always pseudotile=on')
+    hlwm.call('rule label=custom title~.* fullscreen=off')
+    hlwm.call('unrule custom')
+    assert hlwm.list_children('rules') == ['0', '1']
+    assert hlwm.get_attr('rules.1.label') == 'always'
+    assert hlwm.get_attr('rules.1.evaluations') == '0'
+
+    winid, _ = hlwm.create_client()
+
+    # the first rule is never evaluated, because it is looked up by class
+    assert hlwm.get_attr('rules.0.evaluations') == '0'
+    assert hlwm.get_attr('rules.1.evaluations') == '1'
+    assert hlwm.get_attr('rules.1.matches') == '1'
+    assert hlwm.get_attr('rules.1.last_match') == winid
+    lines = hlwm.call('list_rules --stats').stdout.splitlines()
+    assert [line.split('\t')[3] for line in lines] \
+        == ['label=always', 'label=never']
+    assert lines[1].startswith('time=0\tevaluations=0\tmatches=0\t')
+
+    hlwm.call('unrule --all')
+    assert hlwm.list_children('rules') == []
+
+
+def test_list_rules_invalid_argument(hlwm):
+    hlwm.call_xfail('list_rules --foo') \
+        .expect_stderr('Unknown argument')
+
+
 def test_apply_rules_all_no_focus(hlwm):
     hlwm.call('add tag1')
     hlwm.call('rule title=c1 tag=tag1')
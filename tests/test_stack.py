@@ -62,6 +62,66 @@ def test_raise_bottom_client(hlwm):
     assert helper_get_stack_as_list(hlwm, strip_focus_layer=True) == [c1, c2]
 
 
+@pytest.mark.parametrize('raise_order', [[0], [3, 1], [1, 2, 0, 3], [2, 2, 1]])
+def test_raise_updates_x11_stacking_order(hlwm, x11, raise_order):
+    hlwm.call('floating on')
+    clients = hlwm.create_clients(4)
+    decorations = [x11.get_decoration_window(x11.window(c)).id for c in clients]
+
+    # raise them all in one command such that they are restacked at once
+    command = ['chain']
+    for idx in raise_order:
+        command += [',', 'raise', clients[idx]]
+    hlwm.call(command)
+    x11.sync_with_hlwm()
+
+    stack = helper_get_stack_as_list(hlwm)
+    # query_tree() lists the children from bottom to top
+    children = [w.id for w in x11.root.query_tree().children]
+    x11_stack = [clients[decorations.index(w)]
+                 for w in reversed(children) if w in decorations]
+    assert x11_stack == stack
+
+
+def test_raise_and_remove_many_clients(hlwm, x11):
+    hlwm.call('floating on')
+    count = 300
+    windows = {}
+    for _ in range(count):
+        win, winid = x11.create_client(sync_hlwm=False)
+        windows[winid] = win
+    x11.sync_with_hlwm()
+    # new clients are stacked on top
+    expected = list(reversed(list(windows.keys())))
+
+    # raise in a scrambled order, a few clients per command
+    for start in range(0, count, 50):
+        command = ['chain']
+        for i in range(start, start + 50):
+            winid = expected[(i * 7) % count]
+            command += [',', 'raise', winid]
+            expected.remove(winid)
+            expected.insert(0, winid)
+        hlwm.call(command)
+
+    # remove every third client and raise one of the remaining ones
+    for winid in expected[::3]:
+        windows.pop(winid).destroy()
+        expected.remove(winid)
+    x11.display.sync()
+    hlwm.call(['raise', expected[-1]])
+    expected.insert(0, expected.pop())
+    x11.sync_with_hlwm()
+
+    assert helper_get_stack_as_list(hlwm, strip_focus_layer=True) == expected
+    stack = helper_get_stack_as_list(hlwm)
+    decorations = {x11.get_decoration_window(w).id: winid
+                   for winid, w in windows.items()}
+    children = [w.id for w in x11.root.query_tree().children]
+    x11_stack = [decorations[w] for w in reversed(children) if w in decorations]
+    assert x11_stack == stack
+
+
 def create_two_monitors_with_client_each(hlwm):
     hlwm.call('add tag2')
     hlwm.call('set_attr tags.0.floating on')
@@ -256,3 +256,25 @@ def test_urgent_count(hlwm, x11):
 
     # since one of them gets focused, 4 urgent clients remain
     assert int(hlwm.get_attr('tags.focus.urgent_count')) == 4
+
+
+def test_urgent_count_after_moving_and_closing(hlwm, x11):
+    hlwm.call('add other')
+    hlwm.create_client()  # dummy client that gets the focus
+    _, winid1 = x11.create_client(urgent=True)
+    win2, _ = x11.create_client(urgent=True)
+    assert int(hlwm.get_attr('tags.0.urgent_count')) == 2
+
+    hlwm.call(['load', 'other', '(clients max:0 {})'.format(winid1)])
+
+    assert int(hlwm.get_attr('tags.0.urgent_count')) == 1
+    assert int(hlwm.get_attr('tags.1.urgent_count')) == 1
+
+    win2.destroy()
+    x11.display.sync()
+    x11.sync_with_hlwm()
+
+    assert int(hlwm.get_attr('tags.0.urgent_count')) == 0
+    hlwm.call('jumpto urgent')
+    assert hlwm.get_attr('clients.focus.winid') == winid1
+    assert int(hlwm.get_attr('tags.1.urgent_count')) == 0
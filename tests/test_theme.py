@@ -88,3 +88,71 @@ def test_tight_decoration(hlwm, tight_dec):
     # check that it does not crash
     hlwm.create_client()
     hlwm.call('split explode')
+
+
+def test_decoration_update_skipped_if_unchanged(hlwm):
+    winid, _ = hlwm.create_client()
+    attr = 'clients.{}.decoration_skipped_updates'.format(winid)
+    skipped = int(hlwm.get_attr(attr))
+
+    # the tiled client is not affected by the floating theme,
+    # so its decoration does not need to be updated
+    hlwm.call('set_attr theme.floating.active.color red')
+    assert int(hlwm.get_attr(attr)) > skipped
+
+    # changing the tiling theme requires the decoration to be redrawn
+    skipped = int(hlwm.get_attr(attr))
+    hlwm.call('set_attr theme.tiling.active.color red')
+    assert int(hlwm.get_attr(attr)) == skipped
+
+
+def test_proxy_toggle_propagates_typed_value(hlwm):
+    hlwm.call('set_attr theme.tiling.active.tight_decoration true')
+    assert hlwm.get_attr('theme.tight_decoration') == 'false'
+
+    hlwm.call('set_attr theme.tight_decoration toggle')
+
+    # all propagation targets get the new value of the proxy,
+    # regardless of their previous value
+    assert hlwm.get_attr('theme.tight_decoration') == 'true'
+    for scheme in ['active', 'normal', 'urgent']:
+        for deco in ['tiling', 'floating']:
+            attr = f'theme.{deco}.{scheme}.tight_decoration'
+            assert hlwm.get_attr(attr) == 'true'
+
+
+def test_decoration_subwindows_follow_border_widths(hlwm, x11):
+    hlwm.call('set_attr theme.border_width 10')
+    hlwm.call('set_attr theme.outer_width 3')
+    hlwm.call('set_attr theme.inner_width 2')
+    client, _ = x11.create_client()
+    decwin = x11.get_decoration_window(client)
+    # the children are listed from bottom to top: the borderwin is the
+    # lowest child and contains the innerwin
+    borderwin = decwin.query_tree().children[0]
+    innerwin = borderwin.query_tree().children[0]
+
+    def check_geometry(outer_width, inner_width):
+        x11.sync_with_hlwm()
+        dec_geom = decwin.get_geometry()
+        border_geom = borderwin.get_geometry()
+        inner_geom = innerwin.get_geometry()
+        client_geom = client.get_geometry()
+        # the borderwin is inset by the outer border
+        assert (border_geom.x, border_geom.y) == (outer_width, outer_width)
+        assert border_geom.width == dec_geom.width - 2 * outer_width
+        assert border_geom.height == dec_geom.height - 2 * outer_width
+        # the X border of the innerwin is the inner border around the client
+        assert inner_geom.border_width == inner_width
+        assert outer_width + inner_geom.x + inner_width == client_geom.x
+        assert outer_width + inner_geom.y + inner_width == client_geom.y
+        assert inner_geom.width == client_geom.width
+        assert inner_geom.height == client_geom.height
+
+    check_geometry(3, 2)
+
+    hlwm.call('set_attr theme.outer_width 1')
+    check_geometry(1, 2)
+
+    hlwm.call('set_attr theme.inner_width 4')
+    check_geometry(1, 4)
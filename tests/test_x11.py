@@ -47,3 +47,22 @@ def test_client_moveresizes_itself(hlwm, x11):
     assert (win_geo.width, win_geo.height) == (300, 200)
     x, y = x11.get_absolute_top_left(w)
     assert (x, y) == (60, 70)
+
+
+def test_decoration_windows_are_reused(hlwm, x11):
+    hlwm.call('set_attr theme.border_width 5')
+    w1, winid1 = x11.create_client()
+    decwin1 = x11.get_decoration_window(w1)
+    geometry1 = x11.get_absolute_geometry(w1)
+
+    w1.destroy()
+    x11.display.sync()
+    hlwm.call('true')  # sync with hlwm
+    assert winid1 not in hlwm.list_children('clients')
+
+    w2, _ = x11.create_client()
+    # the second client gets the decoration windows of the first one
+    assert x11.get_decoration_window(w2) == decwin1
+    geometry2 = x11.get_absolute_geometry(w2)
+    assert (geometry2.x, geometry2.y, geometry2.width, geometry2.height) \
+        == (geometry1.x, geometry1.y, geometry1.width, geometry1.height)